@@ -0,0 +1,84 @@
+#ifndef AGENT_HPP
+#define AGENT_HPP
+
+//------------------------------
+// Rules
+//------------------------------
+#include "Widgets/GameMap.hpp"            // Rules engine
+#include "Rules/Action.hpp"               // Legal actions
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <memory>                         // std::unique_ptr
+#include <random>                         // std::mt19937
+#include <string>                         // std::string
+#include <vector>                         // std::vector
+
+/**
+ * @brief Player controlled by the computer.
+ *
+ * An agent picks one of the legal actions generated by GameMap::generateMoves().
+ */
+class Agent {
+public:
+    /**
+     * @brief Factory: create an agent from its name ("random" or "greedy").
+     * @param name Name of the agent.
+     * @param seed Seed of the random number generator of the agent.
+     * @return Unique pointer to the new Agent.
+     * @throws std::runtime_error if the name is unknown.
+     */
+    static std::unique_ptr<Agent> create(const std::string& name, unsigned int seed);
+
+    virtual ~Agent() = default;
+
+    /** @brief Return the name of the agent. */
+    virtual const std::string getName() const = 0;
+
+    /**
+     * @brief Choose the next action of the current player.
+     * @param map   Game in progress.
+     * @param moves Legal actions of the current player (never empty).
+     * @return Chosen action.
+     */
+    virtual Action chooseAction(GameMap& map, const std::vector<Action>& moves) = 0;
+};
+
+/**
+ * @brief Agent playing uniformly at random among legal actions.
+ */
+class RandomAgent : public Agent {
+public:
+    /** @param seed Seed of the random number generator. */
+    explicit RandomAgent(unsigned int seed);
+
+    const std::string getName() const override { return "random"; }
+    Action chooseAction(GameMap& map, const std::vector<Action>& moves) override;
+
+private:
+    std::mt19937 gen_;  ///< Random number generator
+};
+
+/**
+ * @brief Agent playing the action with the best immediate gain.
+ *
+ * Captures towns first, then strong elements and territory, buys troops only
+ * when the region can pay their upkeep, and ends its turn otherwise.
+ */
+class GreedyAgent : public Agent {
+public:
+    /** @param seed Seed used to break ties. */
+    explicit GreedyAgent(unsigned int seed);
+
+    const std::string getName() const override { return "greedy"; }
+    Action chooseAction(GameMap& map, const std::vector<Action>& moves) override;
+
+private:
+    std::mt19937 gen_;  ///< Random number generator
+
+    /** @brief Score of an action, negative if it isn't worth playing. */
+    const int evaluate(GameMap& map, const Action& action);
+};
+
+#endif // AGENT_HPP
@@ -0,0 +1,93 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <string>                         // std::string
+#include <vector>                         // std::vector
+#include <memory>                         // std::shared_ptr
+#include <cstdint>                        // std::uint64_t
+
+class GameMap;
+class Player;
+
+/**
+ * @brief Settings of a batch of self-play games.
+ */
+struct ArenaConfig {
+    std::vector<std::string> maps;                   ///< Map files to play
+    std::vector<std::string> agents = {"greedy", "random"}; ///< Agents, assigned to players in turn
+    int gamesPerMap = 10;                            ///< Number of games on each map
+    int threads = 0;                                 ///< Number of workers (0: one per core)
+    int regionThreads = 1;                           ///< Threads of each game sharing its regions (see GameMap::setRegionThreads())
+    int maxTurns = 500;                              ///< Player turns before a game is a draw
+    int maxActionsPerTurn = 100;                     ///< Actions before a turn is ended
+    unsigned int seed = 0;                           ///< Seed of the first game
+    std::string replaysDir;                          ///< Directory where the replays of the games are saved (empty: not saved)
+    std::vector<std::string> replays;                ///< Replay files to play back instead of playing games
+};
+
+/**
+ * @brief Result of one self-play game.
+ */
+struct ArenaResult {
+    std::string map;                                 ///< Map file
+    int game = 0;                                    ///< Index of the game
+    unsigned int seed = 0;                           ///< Seed of the game
+    std::vector<std::string> agents;                 ///< Agent of each player (by player number)
+    int winner = 0;                                  ///< Number of the winner (0 if draw)
+    std::string winnerAgent;                         ///< Agent of the winner (empty if draw)
+    int turns = 0;                                   ///< Number of player turns
+    int actions = 0;                                 ///< Number of played actions
+    double durationMs = 0;                           ///< Duration of the game
+    std::vector<double> turnMs;                      ///< Duration of each player turn
+    std::uint64_t hash = 0;                          ///< Zobrist hash of the final state (finds duplicate games)
+    std::string error;                               ///< Error message if the game failed
+};
+
+/**
+ * @brief Plays self-play games between agents on a pool of threads.
+ *
+ * Games run headless (see Displayer::initHeadless()), one game per worker.
+ * Replays (see Replay) can be played back the same way to check or time them.
+ */
+class Arena {
+public:
+    /**
+     * @brief List the maps of a directory.
+     * @param dir Directory of map files (.ascii or .kmap).
+     * @return Sorted paths of the maps.
+     */
+    static std::vector<std::string> findMaps(const std::string& dir);
+
+    /** @param config Settings of the games. */
+    explicit Arena(const ArenaConfig& config);
+
+    /** @brief Play every game and keep the results. */
+    void run();
+
+    /** @brief Return the results of the games, in the order of the games. */
+    const std::vector<ArenaResult>& getResults() const;
+
+    /** @brief Write one line per game in a CSV file. */
+    void writeCsv(const std::string& path) const;
+
+    /** @brief Write win rates, game lengths and turn timings in a JSON file. */
+    void writeJson(const std::string& path) const;
+
+private:
+    ArenaConfig config_;                             ///< Settings of the games
+    std::vector<ArenaResult> results_;               ///< Results of the games
+
+    /** @brief Play one game until a winner, a draw or an error. */
+    ArenaResult playGame(const std::string& map, int game, unsigned int seed) const;
+
+    /** @brief Play back a replay file at once, without agents. */
+    ArenaResult playReplay(const std::string& path, int game) const;
+
+    /** @brief Return the single player who still has towns (nullptr if none or several). */
+    static std::shared_ptr<Player> searchWinner(const GameMap& gameMap);
+};
+
+#endif // ARENA_HPP
@@ -0,0 +1,82 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <functional>                     // std::function
+#include <map>                            // std::map
+#include <string>                         // std::string
+#include <vector>                         // std::vector
+
+/**
+ * @brief Timing of one benchmark on one map.
+ */
+struct BenchmarkResult {
+    std::string name;                                ///< Name of the benchmark
+    std::string map;                                 ///< Name of the map
+    int cells = 0;                                   ///< Number of cells of the map
+    long iterations = 0;                             ///< Number of timed iterations
+    double meanNs = 0;                               ///< Mean duration of an iteration
+    double medianNs = 0;                             ///< Median duration of an iteration
+    double minNs = 0;                                ///< Fastest iteration
+    std::string skipped;                             ///< Reason if the benchmark couldn't run on the map
+    std::map<std::string, double> counters;          ///< Extra measures per iteration (e.g. blits)
+};
+
+/**
+ * @brief Minimal benchmark harness (no external dependency).
+ *
+ * Each iteration calls an untimed setup, then times the operation alone, until
+ * the minimum time is spent or the maximum number of iterations is reached.
+ */
+class Benchmark {
+public:
+    /**
+     * @param minTimeMs     Time spent in the timed operation of each benchmark.
+     * @param maxIterations Maximum number of iterations of each benchmark.
+     * @param filter        Only run benchmarks whose name contains this string (empty: all).
+     */
+    Benchmark(double minTimeMs, long maxIterations, const std::string& filter);
+
+    /** @brief Check if a benchmark passes the filter. */
+    const bool enabled(const std::string& name) const;
+
+    /**
+     * @brief Time an operation and keep the result.
+     * @param name  Name of the benchmark.
+     * @param map   Name of the map.
+     * @param cells Number of cells of the map.
+     * @param setup Untimed preparation of each iteration (may be empty).
+     * @param op    Timed operation.
+     */
+    void run(const std::string& name, const std::string& map, int cells,
+             const std::function<void()>& setup, const std::function<void()>& op);
+
+    /**
+     * @brief Add a measure to the last result.
+     * @param name  Name of the measure.
+     * @param total Total over every iteration of the last run (warm-up included).
+     */
+    void addCounter(const std::string& name, double total);
+
+    /** @brief Keep a benchmark that couldn't run on a map. */
+    void skip(const std::string& name, const std::string& map, int cells, const std::string& reason);
+
+    /** @brief Return the results, in the order of the runs. */
+    const std::vector<BenchmarkResult>& getResults() const;
+
+    /** @brief Print the results as a table. */
+    void print() const;
+
+    /** @brief Write the results in a CSV file, to compare runs before and after a change. */
+    void writeCsv(const std::string& path) const;
+
+private:
+    double minTimeMs_;                               ///< Time spent in each benchmark
+    long maxIterations_;                             ///< Iterations limit of each benchmark
+    std::string filter_;                             ///< Filter of benchmark names
+    std::vector<BenchmarkResult> results_;           ///< Results of the runs
+};
+
+#endif // BENCHMARK_HPP
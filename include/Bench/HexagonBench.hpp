@@ -0,0 +1,32 @@
+#ifndef HEXAGONBENCH_HPP
+#define HEXAGONBENCH_HPP
+
+//------------------------------
+// Bench
+//------------------------------
+#include "Bench/Benchmark.hpp"            // Timing harness
+
+/**
+ * @brief Benchmarks of the batch conversions of HexagonUtils against the scalar ones.
+ */
+class HexagonBench {
+public:
+    /**
+     * @brief Check that the batch conversions give the same results as the scalar ones.
+     * @param size    Width and height of the checked grid of cells (pixels are
+     *                those of the cells around the origin).
+     * @param hexSize Radius of the hexagons (positive).
+     * @throw std::runtime_error On the first difference.
+     */
+    static void check(int size, double hexSize);
+
+    /**
+     * @brief Time the scalar and batch conversions of every cell of a square grid.
+     * @param bench Harness keeping the results.
+     * @param size    Width and height of the grid in cells.
+     * @param hexSize Radius of the hexagons (positive).
+     */
+    static void run(Benchmark& bench, int size, double hexSize);
+};
+
+#endif // HEXAGONBENCH_HPP
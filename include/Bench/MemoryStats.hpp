@@ -0,0 +1,16 @@
+#ifndef MEMORYSTATS_HPP
+#define MEMORYSTATS_HPP
+
+/**
+ * @brief Heap bytes still allocated, read by the benchmarks of the map footprint.
+ *
+ * konkr_bench replaces the global operator new and delete (see MemoryStats.cpp)
+ * to count them; the game and the other tools keep the default ones.
+ */
+class MemoryStats {
+public:
+    /** @brief Return the bytes allocated by new and not deleted yet. */
+    static const long getLiveBytes();
+};
+
+#endif // MEMORYSTATS_HPP
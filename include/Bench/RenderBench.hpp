@@ -0,0 +1,48 @@
+#ifndef RENDERBENCH_HPP
+#define RENDERBENCH_HPP
+
+//------------------------------
+// Bench
+//------------------------------
+#include "Bench/Benchmark.hpp"            // Timing harness
+
+//------------------------------
+// SDL Wrappers
+//------------------------------
+#include "SDLWrappers/Coords/Size.hpp"    // Resolution of the offscreen window
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <string>                         // std::string
+
+/**
+ * @brief Benchmarks of the rendering of a game (GameMap, GameMenu).
+ *
+ * Frames are drawn by the software renderer of an offscreen Window, so they
+ * run without GPU nor display. Besides the time per frame, each result counts
+ * the blits and the render target switches per frame (see RenderStats).
+ *
+ * Friend of GameMenu to draw its frames without its event loop.
+ */
+class RenderBench {
+public:
+    /**
+     * @brief Open the offscreen window and load the sprites of the game.
+     * @param resolution Size of the offscreen window in pixels.
+     */
+    static void init(const Size& resolution);
+
+    /** @brief Release the sprites and the offscreen window. */
+    static void quit();
+
+    /**
+     * @brief Run every rendering benchmark on a map.
+     * @param bench   Harness keeping the results.
+     * @param mapFile Path of the map.
+     * @param name    Name of the map in the results.
+     */
+    static void run(Benchmark& bench, const std::string& mapFile, const std::string& name);
+};
+
+#endif // RENDERBENCH_HPP
@@ -0,0 +1,39 @@
+#ifndef RULESBENCH_HPP
+#define RULESBENCH_HPP
+
+//------------------------------
+// Bench
+//------------------------------
+#include "Bench/Benchmark.hpp"            // Timing harness
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <string>                         // std::string
+
+/**
+ * @brief Benchmarks of the hot paths of the rules (GameMap, PlayableGround).
+ *
+ * Friend of GameMap to time its private steps one by one, on a headless map.
+ */
+class RulesBench {
+public:
+    /**
+     * @brief Write a synthetic square map: 8x8 regions of 4 players with a town each,
+     *        troops, forests, lakes and neutral lanes with bandits and camps.
+     * @param size Width and height of the map in cells.
+     * @param dir  Directory of the map file.
+     * @return Path of the map file.
+     */
+    static std::string writeSyntheticMap(int size, const std::string& dir);
+
+    /**
+     * @brief Run every benchmark of the rules on a map.
+     * @param bench   Harness keeping the results.
+     * @param mapFile Path of the map.
+     * @param name    Name of the map in the results.
+     */
+    static void run(Benchmark& bench, const std::string& mapFile, const std::string& name);
+};
+
+#endif // RULESBENCH_HPP
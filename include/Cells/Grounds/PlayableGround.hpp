@@ -19,16 +19,19 @@
 #include "Cells/Grounds/Ground.hpp"             // Base class for all ground cells
 #include "GameElements/GameElement.hpp"         // Represents elements placed on grounds
 #include "Displayers/FenceDisplayer.hpp"        // Utility to render fences
+#include "Rules/ZobristHash.hpp"                // Incremental hash of the map
+#include "Rules/MapBitboards.hpp"               // Bitboards of the map
 
 #include <unordered_set>
 #include <queue>
 #include <memory>
+#include <cstdint>
 
 /**
  * @brief A ground cell that can be owned and interacted with.
  *
  * Extends Ground with ownership by a Player, elements placement,
- * selectable state, fence/link mechanics, and income generation.
+ * fence/link mechanics, and income generation.
  *
  * Inherits enable_shared_from_this to allow safe weak/shared pointers.
  */
@@ -106,10 +109,26 @@ public:
 
     /**
      * @brief Check if any fences are present.
+     *
+     * Cached: recomputed only after a change of owner or element nearby.
      * @return true if fences exist.
      */
     const bool hasFences() const;
 
+    /**
+     * @brief Get the neighbors of the same owner that have fences too.
+     *
+     * Cached like hasFences().
+     * @return Mask of the neighbors, bit i for the neighbor i (see FenceDisplayer::display()).
+     */
+    const std::uint8_t getFenceMask() const;
+
+    /**
+     * @brief Mark the fences of this ground as outdated.
+     * Must be called when the neighbors change.
+     */
+    void invalidateFences();
+
     /**
      * @brief Render fences around this ground.
      * @param target Fence texture.
@@ -135,7 +154,7 @@ public:
     void displayCross(const std::weak_ptr<Texture>& target);
 
     /**
-     * @brief Render selection highlight.
+     * @brief Render the highlight of a reachable ground (see GameMap::showReachable()).
      * @param target Selection texture.
      * @param selected Whether it's actively selected.
      */
@@ -176,6 +195,12 @@ public:
      */
     std::shared_ptr<Town> getNearestTown();
 
+    /**
+     * @brief Get the income of this ground: one coin minus the upkeep of its element.
+     * @return Coins given to the nearest town each turn (may be negative).
+     */
+    const int getIncome() const;
+
     /**
      * @brief Update income for the owner based on this ground.
      */
@@ -195,21 +220,33 @@ public:
 
     /**
      * @brief Get current shield/defense value.
+     *
+     * Cached: kept up to date by setOwner() and setElement() on this ground and its neighbors.
      * @return Integer shield strength.
      */
     const int getShield() const;
 
     /**
-     * @brief Update whether this ground is selectable based on strength.
-     * @param strength Value to compare.
+     * @brief Recompute the shield from the elements of this ground and of its neighbors.
+     * Must be called when the neighbors change.
+     */
+    void updateShield();
+
+    /**
+     * @brief Add the owner and the element of this ground to a hash, then keep it up to date.
+     * @param hash Hash of the map.
+     * @param cell Index of this ground in the map (y * width + x).
      */
-    void updateSelectable(int strength);
+    void attachHash(const std::weak_ptr<ZobristHash>& hash, int cell);
 
     /**
-     * @brief Check if ground is marked selectable.
-     * @return true if selectable.
+     * @brief Add the owner and the element of this ground to the bitboards of the map, then keep them up to date.
+     * @param bitboards Bitboards of the map (after attachHash(), which gives the index of this ground).
      */
-    const bool isSelectable() const { return selectable_; }
+    void attachBitboards(const std::weak_ptr<MapBitboards>& bitboards);
+
+    /** @brief Return the index of this ground in the map (see attachHash()), -1 if none. */
+    const int getIndex() const { return hashCell_; }
 
 private:
     // Static display helpers
@@ -219,28 +256,40 @@ private:
     static std::shared_ptr<Texture> selectableSprite_;
     static std::shared_ptr<Texture> crossSprite_;
 
-    // Ownership state
+    // Ownership state (their plates are drawn, see display())
     std::shared_ptr<Player> oldOwner_;
     std::shared_ptr<Player> owner_;
 
-    // Visual plates for linking/highlighting
-    HexagonDisplayer plate_     = HexagonDisplayer{-1, nullptr, nullptr, nullptr, nullptr, nullptr};
-    HexagonDisplayer lostPlate_ = HexagonDisplayer{-1, nullptr, nullptr, nullptr, nullptr, nullptr};
-
     // Placed game element
     std::shared_ptr<GameElement> element = nullptr;
 
-    // Flags
-    bool hasPlate_    = false;
-    bool selectable_  = false;
+    // Strongest element of the owner on this ground and its neighbors (see getShield())
+    int shield_ = 0;
+
+    // Fences, recomputed on demand (see hasFences() and getFenceMask())
+    mutable bool hasFences_          = false;
+    mutable std::uint8_t fenceMask_  = 0;
+    mutable bool hasFencesOutdated_  = true;
+    mutable bool fenceMaskOutdated_  = true;
+
+    // Hash of the map, updated by setOwner() and setElement()
+    std::weak_ptr<ZobristHash> hash_;
+    int hashCell_ = -1;
+
+    // Bitboards of the map, updated by setOwner() and setElement()
+    std::weak_ptr<MapBitboards> bitboards_;
 
-    // Recursive helpers for linking and selection
+    // Update the shield of this ground and of its neighbors
+    void updateShields();
+
+    // Mark as outdated the fences that depend on this ground (up to two cells away)
+    void invalidateNearbyFences();
+
+    // Recursive helpers for linking
     const bool isLinked(std::unordered_set<std::shared_ptr<PlayableGround>>& visited);
     void unlink(std::unordered_set<std::shared_ptr<PlayableGround>>& visited);
     void link(const std::weak_ptr<Player>& owner,
               std::unordered_set<std::shared_ptr<PlayableGround>>& visited);
-    void updateSelectable(int strength,
-                          std::unordered_set<std::shared_ptr<PlayableGround>>& visited);
 
     // Helpers for town retrieval
     void getTowns(std::queue<std::weak_ptr<PlayableGround>>& toVisit,
@@ -251,12 +300,6 @@ private:
 
     // Recursive troop freeing
     void freeTroops(std::unordered_set<std::shared_ptr<PlayableGround>>& visited);
-
-    /**
-     * @brief Internal setter for selectable flag.
-     * @param selectable New selectable state.
-     */
-    void setSelectable(bool selectable);
 };
 
 #endif // PLAYABLEGROUND_HPP
@@ -28,6 +28,15 @@ public:
      */
     static void init(const std::shared_ptr<SDL_Renderer>& renderer);
 
+    /**
+     * @brief Initialize Displayers without renderer (simulations, tools).
+     * Game elements can then be created without sprites, and nothing is drawn.
+     */
+    static void initHeadless();
+
+    /** @brief Check whether Displayers run without renderer. */
+    static const bool isHeadless();
+
     /**
      * @brief Construct a Displayer at a given position and size.
      * @param pos   Initial center position in pixels (default {0,0}).
@@ -77,6 +86,9 @@ protected:
     /// Weak reference to the shared SDL_Renderer, set by init().
     static std::weak_ptr<SDL_Renderer> renderer_;
 
+    /// True if initialized by initHeadless().
+    static bool headless_;
+
     /// Size (width, height) of this object.
     Size size_;
 
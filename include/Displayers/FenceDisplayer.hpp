@@ -4,7 +4,10 @@
 //------------------------------
 // STL & Core SDL2
 //------------------------------
-#include <vector>  // std::vector for neighbor flags
+#include <vector>      // std::vector for pre-baked variants
+#include <array>       // std::array of the neighbor masks
+#include <cstdint>     // std::uint8_t for neighbor masks
+#include <functional>  // std::function for segment visitors
 #include "SDL.h"    // SDL_Point, basic SDL types
 
 //------------------------------
@@ -23,6 +26,8 @@
  * 
  * FenceDisplayer chooses between straight or “linked” fence textures for each
  * of the six hexagon sides, depending on which neighbors are present.
+ * The 64 combinations of neighbors are drawn once at construction, so a
+ * fenced cell costs a single blit.
  */
 class FenceDisplayer : public GenericDisplayer {
 public:
@@ -81,15 +86,18 @@ public:
      *        based on which of the six neighbors exist.
      * @param target Weak pointer to the render target.
      * @param pos Center point in pixel coordinates.
-     * @param neighbors Boolean flags for each hex side in this order:
+     * @param neighbors Mask of the neighbors, bit i for the side i in this order:
      *        {top, top-right, bottom-right, bottom, bottom-left, top-left}.
      */
     void display(
         const std::weak_ptr<BlitTarget>& target,
         const Point& pos,
-        const std::vector<bool>& neighbors
+        std::uint8_t neighbors
     ) const;
 
+    /// Number of combinations of neighbors (one pre-baked variant each).
+    static constexpr int NB_VARIANTS = 64;
+
 private:
     /// Outer radius of the hexagon cell.
     double radius_;
@@ -112,6 +120,23 @@ private:
     std::shared_ptr<Texture> linkBottom_;
     std::shared_ptr<Texture> linkBottomLeft_;
     std::shared_ptr<Texture> linkBottomRight_;
+
+    /// Fence of each combination of neighbors (nullptr if it has no segment).
+    std::vector<std::shared_ptr<Texture>> variants_;
+
+    /// Position of the cell center in the variants.
+    Point variantCenter_;
+
+    /**
+     * @brief Visit the segments of a combination of neighbors.
+     * @param neighbors Mask of the neighbors (see display()).
+     * @param visit     Called with each texture and the offset of its top-left corner from the cell center.
+     */
+    void forEachSegment(std::uint8_t neighbors,
+                        const std::function<void(const std::shared_ptr<Texture>&, double, double)>& visit) const;
+
+    /** @brief Draw the fence of every combination of neighbors. */
+    void createVariants();
 };
 
 #endif // FENCEDISPLAYER_HPP
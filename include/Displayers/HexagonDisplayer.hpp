@@ -17,14 +17,17 @@
 //------------------------------
 #include "GenericDisplayer.hpp" // Provides position and size handling
 
-#include <vector>  // std::vector for neighbor flags
-#include <memory>  // std::shared_ptr, std::weak_ptr
+#include <memory>      // std::shared_ptr, std::weak_ptr
+#include <cstdint>     // std::uint8_t for neighbor masks
+#include <functional>  // std::function for part visitors
 
 /**
  * @brief Renders a hexagon tile with optional connection links.
  *
  * GenericDisplayer provides position/size; HexagonDisplayer draws a hexagon
  * texture plus link textures to neighboring hexes based on adjacency flags.
+ * The 16 combinations of linked neighbors are drawn once in an atlas, so a
+ * hexagon costs a single blit.
  */
 class HexagonDisplayer : public GenericDisplayer {
 public:
@@ -67,20 +70,24 @@ public:
      * @brief Draw the hexagon at a given position with neighbor links.
      * @param target    Weak pointer to the render target.
      * @param pos       Center point in pixel coordinates.
-     * @param neighbors Boolean flags for adjacency in each of 6 directions.
+     * @param neighbors Mask of adjacency, bit i for the neighbor i (only the
+     *                  LINKED_NEIGHBORS first ones have links, the others are ignored).
      */
     void display(const std::weak_ptr<BlitTarget>& target,
                  const Point& pos,
-                 const std::vector<bool>& neighbors) const;
+                 std::uint8_t neighbors) const;
 
-    /**
-     * @brief Create a deep copy of this displayer (including cloned textures).
-     * @return A new HexagonDisplayer with its own textures.
-     */
-    HexagonDisplayer copy();
+    /// Neighbors that a hexagon is linked to (the others draw the link to it).
+    static constexpr int LINKED_NEIGHBORS = 4;
+
+    /// Number of combinations of linked neighbors (one variant each in the atlas).
+    static constexpr int NB_VARIANTS = 1 << LINKED_NEIGHBORS;
 
     /**
-     * @brief Apply a color modulation to all hexagon and link textures.
+     * @brief Tint the hexagon and its links.
+     *
+     * The tint is applied when drawing: copies of a displayer share the same
+     * atlas and can each have their own color.
      * @param color SDL_Color to tint the textures.
      */
     void colorize(const SDL_Color& color);
@@ -94,6 +101,22 @@ private:
     std::shared_ptr<Texture> linkBottomLeft_;  ///< Bottom-left link texture
     std::shared_ptr<Texture> linkBottom_;      ///< Bottom link texture
     std::shared_ptr<Texture> linkBottomRight_; ///< Bottom-right link texture
+
+    std::shared_ptr<Texture> atlas_;           ///< Variants side by side, by combination of neighbors
+    Size variantSize_;                         ///< Size of a variant in the atlas
+    Point variantCenter_;                      ///< Position of the hexagon center in a variant
+    SDL_Color tint_{255, 255, 255, 255};       ///< Color modulation of the atlas when drawing (see colorize())
+
+    /**
+     * @brief Visit the hexagon and the links of a combination of neighbors.
+     * @param neighbors Mask of the neighbors (see display()).
+     * @param visit     Called with each texture and the offset of its top-left corner from the center.
+     */
+    void forEachPart(std::uint8_t neighbors,
+                     const std::function<void(const std::shared_ptr<Texture>&, double, double)>& visit) const;
+
+    /** @brief Draw every combination of neighbors in the atlas. */
+    void createAtlas();
 };
 
 #endif // HEXAGONDISPLAYER_HPP
@@ -0,0 +1,51 @@
+#ifndef PROFILERDISPLAYER_HPP
+#define PROFILERDISPLAYER_HPP
+
+//------------------------------
+// Base Classes & Text Rendering
+//------------------------------
+#include "Displayers/Displayer.hpp"       // Base class for renderable objects
+#include "SDLWrappers/Font.hpp"           // Wraps TTF_Font for text rendering
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <memory>                         // std::shared_ptr
+#include <vector>                         // std::vector
+
+/**
+ * @brief Panel showing the rolling percentiles of the FrameProfiler stages.
+ *
+ * One line per stage with its p50, p95 and p99 over the last frames. The text
+ * is rebuilt a few times per second by update(), not at every frame.
+ */
+class ProfilerDisplayer : public Displayer {
+public:
+    /** @brief Load the font of the panel. */
+    static void init();
+
+    /** @brief Release the font. */
+    static void quit();
+
+    /** @param pos Top-left corner of the panel. */
+    explicit ProfilerDisplayer(const Point& pos);
+
+    /** @brief Rebuild the text from the profiler if it is old enough. */
+    void update();
+
+    /**
+     * @brief Draw the panel onto a BlitTarget.
+     * @param target Weak pointer to the rendering target.
+     */
+    void display(const std::weak_ptr<BlitTarget>& target) const override;
+
+private:
+    /// Shared font of the panels.
+    static std::shared_ptr<Font> font_;
+
+    std::shared_ptr<Texture> bg_;                 ///< Translucent background
+    std::vector<std::shared_ptr<Texture>> lines_; ///< Header then one line per stage
+    Uint32 lastUpdate_ = 0;                       ///< Time of the last rebuild in ms
+};
+
+#endif // PROFILERDISPLAYER_HPP
@@ -5,6 +5,7 @@
 // C++ Standard Library
 //------------------------------
 #include <memory>               // std::shared_ptr, std::make_shared
+#include <string>               // std::string
 
 //------------------------------
 // SDL2 Core
@@ -53,8 +54,10 @@ class Game {
 public:
     /**
      * @brief Construct the Game, initialize SDL, create window, and load global resources.
+     * @param replayFile  Replay to play back instead of opening the main menu (empty for none).
+     * @param replayDelay Delay between two actions of the replay in ms (0 plays it at once).
      */
-    Game();
+    Game(const std::string& replayFile = "", int replayDelay = 500);
 
     /**
      * @brief Destroy the Game, free all resources and quit SDL subsystems.
@@ -66,6 +69,15 @@ public:
      */
     void run();
 
+    /**
+     * @brief Load the resources shared by every map (sprites, fonts), except the cursors.
+     * @param renderer Renderer of the window.
+     */
+    static void initResources(const std::shared_ptr<SDL_Renderer>& renderer);
+
+    /** @brief Release the resources loaded by initResources(). */
+    static void quitResources();
+
 private:
     /// Currently active menu (MainMenu, MapsMenu, GameMenu, etc.)
     std::shared_ptr<MenuBase> menu_;
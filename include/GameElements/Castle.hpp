@@ -68,6 +68,9 @@ public:
     const int getCost()     const override { return COST;     }
     const int getUpkeep()   const override { return UPKEEP;   }
 
+    /// Treasury needed for the shop to unlock castles
+    static constexpr int SHOP_TREASURY = 20;
+
 protected:
     /// Base combat strength of a castle
     static constexpr int STRENGTH = 2;
@@ -32,6 +32,13 @@ public:
     /// Virtual destructor to allow proper cleanup in derived classes.
     virtual ~GameElement() = default;
 
+    /**
+     * @brief Code of an element in map files (reverse of GameMap::createGameElement()).
+     * @param elt Element to identify.
+     * @return Code of the element, '.' if none.
+     */
+    static char getLetter(const std::shared_ptr<GameElement>& elt);
+
     /* --- Generic Accessors --- */
 
     /**
@@ -86,6 +93,12 @@ protected:
      */
     GameElement(const Point& pos, const Size& size);
 
+    /**
+     * @brief Size of a sprite, or an empty size if it isn't loaded (headless).
+     * @param sprite Sprite of the element.
+     */
+    static Size getSpriteSize(const std::shared_ptr<Texture>& sprite);
+
     // Default values for derived classes that don't override these.
     static constexpr int STRENGTH = 0;
     static constexpr int COST     = 0;
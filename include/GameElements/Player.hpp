@@ -8,6 +8,7 @@
 #include <memory>             // std::shared_ptr, std::weak_ptr
 #include <unordered_set>      // std::unordered_set for collections of grounds
 #include <vector>             // std::vector for town cell list
+#include <span>               // std::span for read-only town cell access
 
 //------------------------------
 // SDL2 Rendering
@@ -74,12 +75,6 @@ public:
      */
     HexagonDisplayer& getLostPlate();
 
-    /**
-     * @brief Remove entries for towns that have been destroyed.
-     * Called at start of turn to prune stale town records.
-     */
-    void updateTowns();
-
     /**
      * @brief Check if the player has been selected for this turn.
      * @return True if onTurnStart was called without a matching onTurnEnd.
@@ -88,22 +83,37 @@ public:
 
     /**
      * @brief Determine if the player currently owns at least one town.
-     * @return True if any townCells_ entry still contains a Town.
+     * @return True if townCells_ is not empty.
      */
-    const bool hasTowns();
+    const bool hasTowns() const;
 
     /**
-     * @brief Access the list of owned town cells.
-     * @return Vector of weak_ptr to PlayableGrounds containing towns.
+     * @brief Access the list of owned town cells, in the order they were added.
+     *
+     * Kept up to date by the cells themselves (see PlayableGround::setOwner() and
+     * PlayableGround::setElement()), and by the map when it replaces cells (see
+     * GameMap::setInSelectedCell() and GameMap::undo()): no copy nor scan. The span
+     * is invalidated when a town is added or removed.
+     *
+     * @return Span of weak_ptr to PlayableGrounds containing towns.
      */
-    std::vector<std::weak_ptr<PlayableGround>> getTownCells();
+    std::span<const std::weak_ptr<PlayableGround>> getTownCells() const;
 
     /**
-     * @brief Add a new town cell to this player's ownership.
+     * @brief Add a new town cell to this player's ownership (once).
      * @param town Weak pointer to the PlayableGround hosting the town.
      */
     void addTownCell(std::weak_ptr<PlayableGround> town);
 
+    /**
+     * @brief Remove a town cell captured, destroyed or lost by this player.
+     * @param town PlayableGround which no longer hosts a town of this player.
+     */
+    void removeTownCell(const PlayableGround* town);
+
+    /** @brief Forget every town cell (before the cells are replaced, see GameMap::undo()). */
+    void clearTownCells();
+
     /**
      * @brief Mark the start of this player's turn.
      * Sets selected_, highlights towns, and resets incomes.
@@ -132,10 +142,9 @@ private:
     GroundColor color_;                            // This player's color scheme
     int num_ = 1;
 
-    HexagonDisplayer plate_;                       // Colored owned-plate instance
-    HexagonDisplayer lostPlate_;                   // Colored available-plate instance
+    HexagonDisplayer plate_;                       // Owned plate, tinted with the owned color
+    HexagonDisplayer lostPlate_;                   // Available plate, tinted with the available color
 
-    std::vector<std::weak_ptr<PlayableGround>> allTownCells_; // Cells containing this player's all towns
     std::vector<std::weak_ptr<PlayableGround>> townCells_; // Cells containing this player's towns
 
     bool selected_ = false;                        // True while it's this player's turn
@@ -0,0 +1,50 @@
+#ifndef BINARYMAP_HPP
+#define BINARYMAP_HPP
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <string>                         // std::string
+#include <utility>                        // std::pair
+
+/**
+ * @brief Map in the binary format (.kmap), loaded without parsing text.
+ *
+ * Cells use the same two letters as the ASCII format (see README), stored
+ * row after row without separators.
+ *
+ * Binary format (little endian):
+ *   - "KMAP", version (u8), width (u32), height (u32)
+ *   - width * height cells of 2 bytes (cell letter, element letter)
+ */
+struct BinaryMap {
+    /** @brief Extension of the binary map files. */
+    static constexpr const char* EXTENSION = ".kmap";
+
+    /** @brief Check whether a map file is in the binary format (from its extension). */
+    static const bool isBinary(const std::string& path);
+
+    /**
+     * @brief Read the width and height of a binary map without its cells.
+     * @throws std::runtime_error if the file can't be read or is malformed (empty size included).
+     */
+    static std::pair<int, int> readSize(const std::string& path);
+
+    /**
+     * @brief Read a binary map.
+     * @throws std::runtime_error if the file can't be read or is malformed (empty size included).
+     */
+    static BinaryMap load(const std::string& path);
+
+    /**
+     * @brief Write the map in the binary format.
+     * @throws std::runtime_error if the file can't be written.
+     */
+    void save(const std::string& path) const;
+
+    int width = 0;                    ///< Width in cells
+    int height = 0;                   ///< Height in cells
+    std::string cells;                ///< Two letters per cell, row after row
+};
+
+#endif // BINARYMAP_HPP
@@ -0,0 +1,82 @@
+#ifndef MAPGENERATOR_HPP
+#define MAPGENERATOR_HPP
+
+//------------------------------
+// Map Formats
+//------------------------------
+#include "MapGen/BinaryMap.hpp"           // Generated cells and binary output
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <string>                         // std::string
+#include <utility>                        // std::pair
+#include <vector>                         // std::vector
+
+/**
+ * @brief Settings of a generated map.
+ */
+struct MapGeneratorConfig {
+    int width = 64;                   ///< Width in cells
+    int height = 64;                  ///< Height in cells
+    int players = 4;                  ///< Number of players (1 to 9)
+    unsigned int seed = 0;            ///< Seed of the noise and of the placements
+    double water = 0.35;              ///< Share of the cells under water
+    double forests = 0.10;            ///< Share of the land cells covered by forests
+    double camps = 0.004;             ///< Camps per land cell
+    double bandits = 0.006;           ///< Bandits per land cell
+    int territoryRadius = 2;          ///< Radius of the starting territory of the players
+};
+
+/**
+ * @brief Procedural maps to stress the game on large grids.
+ *
+ * Islands and forests come from value noise (fractal, tiled on the lattice of
+ * the hexagons), with borders sinking into the sea. Players start as far as
+ * possible from each other on the largest island, with a town, a villager and
+ * a small territory; camps and bandits are scattered on the neutral land.
+ */
+class MapGenerator {
+public:
+    /**
+     * @brief Generate a map.
+     * @param config Settings of the map.
+     * @throws std::runtime_error if the settings are invalid or the land is too small for the players.
+     */
+    explicit MapGenerator(const MapGeneratorConfig& config);
+
+    /** @brief Return the generated cells (two letters per cell, as in the ASCII format). */
+    const BinaryMap& getMap() const;
+
+    /** @brief Write the map in the ASCII format. */
+    void saveAscii(const std::string& path) const;
+
+    /** @brief Write the map in the binary format. */
+    void saveBinary(const std::string& path) const;
+
+    /** @brief Write the map in the format given by the extension of the path (.kmap or .ascii). */
+    void save(const std::string& path) const;
+
+private:
+    MapGeneratorConfig config_;       ///< Settings of the map
+    BinaryMap map_;                   ///< Generated cells
+
+    /** @brief Fractal value noise in [0, 1] at a cell. */
+    double noise(int x, int y, unsigned int layer) const;
+
+    /** @brief Return the valid neighbors of a cell (offset coordinates, odd rows shifted). */
+    std::vector<std::pair<int, int>> neighbors(int x, int y) const;
+
+    /** @brief Set the letters of a cell. */
+    void setCell(int x, int y, char cell, char element);
+
+    /** @brief Return the letter of the ground of a cell. */
+    char getCell(int x, int y) const;
+
+    void generateTerrain();                           ///< Water, land and forests
+    std::vector<int> largestLand() const;             ///< Cells of the largest island
+    void placePlayers(const std::vector<int>& land);  ///< Towns, villagers and territories
+    void placeNeutrals();                             ///< Camps and bandits
+};
+
+#endif // MAPGENERATOR_HPP
@@ -23,8 +23,16 @@
 #include "Widgets/Overlay.hpp"   // Semi-transparent overlay widget
 #include "Widgets/GameMap.hpp"   // Interactive game map widget
 #include "Widgets/Button.hpp"    // Clickable button widget
+#include "Displayers/ProfilerDisplayer.hpp"  // Timings of the frame profiler
+
+//------------------------------
+// Rules
+//------------------------------
+#include "Rules/Replay.hpp"        // Log of the played actions
+#include "Rules/ReplayPlayer.hpp"  // Play back of a replay
 
 #include <memory>
+#include <optional>
 #include <string>
 
 /** 
@@ -49,6 +57,16 @@ public:
      */
     GameMenu(const std::shared_ptr<Window>& window, const std::string& mapPath);
 
+    /**
+     * @brief Create a GameMenu that plays back a replay.
+     *
+     * The player can only move and zoom the map; one action is played every replayDelay ms.
+     * @param window      Shared pointer to the application window/renderer.
+     * @param replay      Replay to play back.
+     * @param replayDelay Delay between two actions in ms (0 plays everything at once).
+     */
+    GameMenu(const std::shared_ptr<Window>& window, const Replay& replay, int replayDelay);
+
     /** @brief Default destructor. */
     ~GameMenu() = default;
 
@@ -63,15 +81,24 @@ protected:
      * @brief Handle all pending SDL events.
      *
      * Invokes specialized callbacks for mouse, keyboard, and overlay.
+     * Mouse motions are coalesced: only the last one before another event is handled.
      */
     void handleEvents() override;
 
+    /**
+     * @brief Handle one event: the game, the overlay, then the menu.
+     * @param event SDL event (mouse motions are coalesced per frame, see handleEvents()).
+     */
+    void dispatchEvent(SDL_Event& event);
+
     /**
      * @brief Draw all widgets (map, overlay, buttons) to the screen.
      */
     void draw() override;
 
 private:
+    friend class RenderBench;               ///< Draws frames without the event loop
+
     // Widgets and textures
     std::unique_ptr<GameMap>      map_;         ///< Interactive hex map
     std::unique_ptr<Overlay>      overlay_;     ///< GUI overlay (e.g., stats panel)
@@ -95,6 +122,7 @@ private:
     // Frame tracking for performance/logging
     int     frameCount_;                   
     Uint32  lastLogTime_;                  
+    std::unique_ptr<ProfilerDisplayer> profiler_;  ///< Stage timings, shown with F3
 
     // Drag-and-drop state for map panning
     std::optional<Point> moveOrigin_;      ///< Where the drag started
@@ -103,8 +131,16 @@ private:
     // Game state
     bool gameFinished_     = false;        ///< Has the player finished their turn?
 
+    // Replay state
+    std::unique_ptr<ReplayPlayer> replayPlayer_;  ///< Player of the replay (nullptr if the game is played)
+    int    replayDelay_    = 0;                   ///< Delay between two actions of the replay in ms
+    Uint32 lastReplayStep_ = 0;                   ///< Time of the last action of the replay
+
     // Initialization helpers
-    void createMap(const std::string& mapPath);  ///< Load and instantiate the GameMap
+    void createWidgets();                        ///< Create overlay and buttons
+    void createMap(const std::string& mapPath, unsigned int seed);  ///< Load and instantiate the GameMap
+    void stepReplay();                           ///< Play the actions of the replay that are due
+    void saveReplay() const;                     ///< Save the actions of the game in replays/
     void updateMapPos();                         ///< Recalculate mapPos_ on resize/zoom
     void updateShop();                           ///< Refresh shop items if implemented
 
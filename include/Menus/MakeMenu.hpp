@@ -22,6 +22,7 @@
 //------------------------------
 #include "Widgets/GameMap.hpp"   // Interactive game map widget
 #include "Widgets/Button.hpp"    // Clickable button widget
+#include "Displayers/ProfilerDisplayer.hpp"  // Timings of the frame profiler
 #include "GameElements/Player.hpp"    // Clickable button widget
 
 #include <memory>
@@ -85,6 +86,7 @@ private:
     // Frame tracking for performance/logging
     int     frameCount_;                   
     Uint32  lastLogTime_;                  
+    std::unique_ptr<ProfilerDisplayer> profiler_;  ///< Stage timings, shown with F3
 
     // Drag-and-drop state for map panning
     std::optional<Point> moveOrigin_;      ///< Where the drag started
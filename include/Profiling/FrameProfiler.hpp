@@ -0,0 +1,93 @@
+#ifndef FRAMEPROFILER_HPP
+#define FRAMEPROFILER_HPP
+
+//------------------------------
+// SDL2 Core
+//------------------------------
+#include "SDL.h"                          // Uint64, SDL_GetPerformanceCounter
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <deque>                          // std::deque
+#include <string>                         // std::string
+#include <vector>                         // std::vector
+
+/**
+ * @brief Timings of the stages of the frames (events, map layers, overlay, present).
+ *
+ * Stages are timed by ProfileScope between beginFrame() and endFrame(). The time of
+ * each stage in the last frames gives rolling percentiles, shown by ProfilerDisplayer,
+ * and every timed scope is kept to be exported as a Chrome trace (chrome://tracing,
+ * Perfetto). Nothing is recorded while the profiler is disabled.
+ */
+class FrameProfiler {
+public:
+    /** @brief Enable or disable the recording (disabling keeps the recorded timings). */
+    static void setEnabled(bool enabled);
+
+    /** @brief Check whether the timings are recorded. */
+    static const bool isEnabled();
+
+    /** @brief Start a frame: the next scopes are added to it. */
+    static void beginFrame();
+
+    /** @brief End the frame: keep the time of each stage in its history. */
+    static void endFrame();
+
+    /**
+     * @brief Record a timed scope.
+     * @param name  Name of the stage (static string).
+     * @param start Performance counter at the start of the scope.
+     * @param end   Performance counter at the end of the scope.
+     */
+    static void record(const char* name, Uint64 start, Uint64 end);
+
+    /** @brief Return the names of the recorded stages, in order of first appearance. */
+    static std::vector<std::string> getStages();
+
+    /**
+     * @brief Return a percentile of the time of a stage over the last frames.
+     * @param stage Name of the stage ("frame" for whole frames).
+     * @param p     Percentile, between 0 and 100.
+     * @return Time in ms (0 if the stage has no history).
+     */
+    static const double percentile(const std::string& stage, double p);
+
+    /**
+     * @brief Write the recorded scopes in the Chrome trace JSON format.
+     * @param path Path of the JSON file.
+     * @throws std::runtime_error if the file can't be written.
+     */
+    static void writeTrace(const std::string& path);
+
+    /** @brief Forget every recorded timing. */
+    static void reset();
+
+private:
+    /// Time of a stage in the current frame and in the last ones
+    struct Stage {
+        std::string name;
+        double frameMs = 0;
+        std::deque<double> history{};
+    };
+
+    /// Scope kept for the trace
+    struct TraceEvent {
+        const char* name;
+        Uint64 start;
+        Uint64 end;
+    };
+
+    static bool enabled_;                     ///< Recording state
+    static bool inFrame_;                     ///< Between beginFrame() and endFrame()
+    static Uint64 frameStart_;                ///< Performance counter at beginFrame()
+    static Uint64 origin_;                    ///< Performance counter of the earliest recorded scope
+    static std::vector<Stage> stages_;        ///< Stages, in order of first appearance
+    static std::vector<TraceEvent> trace_;    ///< Recorded scopes
+
+    /** @brief Return the stage of a name, created if needed. */
+    static Stage& getStage(const char* name);
+};
+
+#endif // FRAMEPROFILER_HPP
@@ -0,0 +1,39 @@
+#ifndef PROFILESCOPE_HPP
+#define PROFILESCOPE_HPP
+
+//------------------------------
+// Profiling
+//------------------------------
+#include "Profiling/FrameProfiler.hpp"    // Receives the timings
+
+/**
+ * @brief Times the scope where it lives as a stage of the FrameProfiler.
+ *
+ *   {
+ *       ProfileScope scope{"islands"};
+ *       ...
+ *   }
+ *
+ * Costs a single check when the profiler is disabled.
+ */
+class ProfileScope {
+public:
+    /** @param name Name of the stage (static string). */
+    explicit ProfileScope(const char* name)
+        : name_(name), start_(FrameProfiler::isEnabled() ? SDL_GetPerformanceCounter() : 0) {}
+
+    /** @brief Record the scope in the profiler. */
+    ~ProfileScope() {
+        if (start_ && FrameProfiler::isEnabled())
+            FrameProfiler::record(name_, start_, SDL_GetPerformanceCounter());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name_;    ///< Name of the stage
+    Uint64 start_;        ///< Performance counter at the start (0 if disabled)
+};
+
+#endif // PROFILESCOPE_HPP
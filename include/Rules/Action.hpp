@@ -0,0 +1,44 @@
+#ifndef ACTION_HPP
+#define ACTION_HPP
+
+//------------------------------
+// Coordinates
+//------------------------------
+#include "SDLWrappers/Coords/Point.hpp"   // Grid coordinates of cells
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <cstdint>                        // std::uint8_t
+
+/**
+ * @brief A single legal action of the current player.
+ *
+ * Produced by GameMap::generateMoves() and replayed by GameMap::applyAction().
+ * Coordinates are grid (offset) coordinates, not pixels.
+ */
+struct Action {
+    /// Kind of action
+    enum class Type : std::uint8_t {
+        Move,       ///< Move a troop (inside its territory, onto a bandit or into an enemy cell)
+        Merge,      ///< Merge a troop with a troop of the same kind
+        Buy,        ///< Buy a troop with the treasury of a region and place it
+        Castle,     ///< Place a castle on an empty cell of the player
+        EndTurn,    ///< Hand over to the next player
+        Undo        ///< Undo the last action of the turn
+    };
+
+    /// Origin of a bought troop
+    enum class Source : std::uint8_t {
+        Town,       ///< Bought by the region of the town cell from
+        Shop        ///< Bought from the shop by any region able to pay
+    };
+
+    Type type = Type::EndTurn;      ///< Kind of action
+    Point from;                     ///< Troop cell (Move/Merge), town cell of the buying region (Buy from a town), target cell (Buy from the shop, Castle)
+    Point to;                       ///< Target cell
+    char element = '.';             ///< Letter of the bought element ('V', 'P', 'K', 'H' or 'C'), '.' otherwise
+    Source source = Source::Town;   ///< Origin of the bought troop (Buy), Town otherwise
+};
+
+#endif // ACTION_HPP
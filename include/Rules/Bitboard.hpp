@@ -0,0 +1,124 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <cstdint>                        // std::uint64_t
+#include <memory>                         // std::shared_ptr
+#include <vector>                         // std::vector
+
+/**
+ * @brief One bit per cell of a hexagon grid (bit y * width + x), in 64-bit words.
+ *
+ * Set operations work on whole words. Hexagon neighbors are shifts of the whole
+ * board: +-1 for the same row, +-width for the rows above and below, and +-(width +- 1)
+ * for the diagonal neighbors, which depend on the parity of the row. Masks of the
+ * first and last columns and of the odd rows drop the bits that a shift carries
+ * to the wrong row; they are shared by every board of the same size.
+ */
+class Bitboard {
+public:
+    /** @brief Empty board of size 0. */
+    Bitboard() = default;
+
+    /**
+     * @brief Empty board of a grid.
+     * @param width, height Size of the grid, in cells.
+     */
+    Bitboard(int width, int height);
+
+    /// Range of words [first, last) of a board
+    struct Span {
+        size_t first = 0;                             ///< First word
+        size_t last = 0;                              ///< Word after the last one
+
+        const bool empty() const { return first >= last; }
+    };
+
+    const int getWidth() const { return width_; }
+    const int getHeight() const { return height_; }
+
+    /** @brief Return the words of the board (bits past the last cell are zero). */
+    const std::vector<std::uint64_t>& getWords() const { return words_; }
+
+    /** @brief Return a word of the board (cells 64 * i to 64 * i + 63), to combine boards on some words only. */
+    std::uint64_t& word(size_t i) { return words_[i]; }
+
+    /** @brief Return the words from the first to the last one holding a set cell (empty if none). */
+    Span getSpan() const;
+
+    /**
+     * @brief Widen a range of words by the words that one dilation may reach.
+     * @return The words of span and those of the neighbors of its cells.
+     */
+    Span widen(const Span& span) const;
+
+    void set(int cell) { words_[cell / 64] |= std::uint64_t{1} << (cell % 64); }
+    void reset(int cell) { words_[cell / 64] &= ~(std::uint64_t{1} << (cell % 64)); }
+    const bool test(int cell) const { return (words_[cell / 64] >> (cell % 64)) & 1; }
+
+    /** @brief Reset every cell. */
+    void clear();
+
+    /** @brief Check if any cell is set. */
+    const bool any() const;
+
+    Bitboard& operator|=(const Bitboard& other);
+    Bitboard& operator&=(const Bitboard& other);
+
+    /** @brief Reset the cells set in another board. */
+    Bitboard& andNot(const Bitboard& other);
+
+    const bool operator==(const Bitboard& other) const { return words_ == other.words_; }
+
+    /**
+     * @brief Write the set cells and all their neighbors in some words of a board.
+     *
+     * Only the words of this board in widen(span) are read, so the others may
+     * hold anything (e.g. a scratch board only filled around a region).
+     *
+     * @param out  Board of the same size (its other words are left as they are).
+     * @param span Words to compute.
+     */
+    void dilateInto(Bitboard& out, const Span& span) const;
+
+    /**
+     * @brief Return the set cells connected to a cell (empty if it isn't set).
+     *
+     * Dilates from the cell and keeps the cells of this board, until nothing
+     * changes. Each step only computes the words around those the last step
+     * changed, so the cost follows the region rather than the map.
+     *
+     * @param cell Index of the first cell.
+     */
+    Bitboard flood(int cell) const;
+
+private:
+    /// Masks of the cells that shifts may not reach, for one grid size
+    struct Masks {
+        std::vector<std::uint64_t> notFirstColumn;    ///< Every cell but those of column 0
+        std::vector<std::uint64_t> notLastColumn;     ///< Every cell but those of the last column
+        std::vector<std::uint64_t> oddRows;           ///< Cells of odd rows
+        std::vector<std::uint64_t> evenRows;          ///< Cells of even rows
+    };
+
+    int width_ = 0;                                   ///< Width of the grid
+    int height_ = 0;                                  ///< Height of the grid
+    std::vector<std::uint64_t> words_;                ///< Bits of the cells
+    std::shared_ptr<const Masks> masks_;              ///< Masks of this grid size
+
+    /**
+     * @brief OR the neighbors of one direction, in the words [first, last), into a board.
+     *
+     * Cell (x, y) is set in out if its neighbor in this direction is set. Directions
+     * are those of GameMap::getNeighborIndex() (and of GameMap::updateNeighbors()).
+     *
+     * @param out         Board of the same size.
+     * @param direction   Neighbor direction in [0, 6).
+     * @param first, last Range of words to compute.
+     */
+    void orNeighbors(Bitboard& out, int direction, size_t first, size_t last) const;
+};
+
+#endif // BITBOARD_HPP
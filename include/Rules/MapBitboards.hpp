@@ -0,0 +1,95 @@
+#ifndef MAPBITBOARDS_HPP
+#define MAPBITBOARDS_HPP
+
+//------------------------------
+// Rules
+//------------------------------
+#include "Rules/Bitboard.hpp"             // One bit per cell
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <memory>                         // std::shared_ptr
+#include <vector>                         // std::vector
+
+class GameElement;
+
+/**
+ * @brief Owners and elements of the cells of a map, as bitboards.
+ *
+ * One board per player (board 0: playable cells without owner) and one per element
+ * strength. PlayableGround updates them in setOwner() and setElement(), like
+ * ZobristHash, so they stay up to date in O(1) per change.
+ *
+ * Regions, the cells around them and shields are then computed with whole-word
+ * operations (see Bitboard) instead of walking the cells, and only on the words
+ * around the region: a troop's moves cost the size of its region, not of the map.
+ */
+class MapBitboards {
+public:
+    /**
+     * @brief Empty boards of a map.
+     * @param width, height Size of the map, in cells.
+     */
+    MapBitboards(int width, int height);
+
+    /** @brief Add a playable cell, without owner nor element. */
+    void addPlayable(int cell);
+
+    /** @brief Move a cell from the board of a player to another (0: nobody). */
+    void setOwner(int cell, int oldPlayer, int player);
+
+    /** @brief Replace the element of a cell in the boards of strengths. */
+    void setElement(int cell, const std::shared_ptr<GameElement>& oldElt, const std::shared_ptr<GameElement>& elt);
+
+    /** @brief Return the playable cells. */
+    const Bitboard& getPlayable() const { return playable_; }
+
+    /**
+     * @brief Return the cells whose shield is at least a strength.
+     *
+     * Same shield as PlayableGround::getShield(): the strongest element of the cell
+     * and of its neighbors of the same owner.
+     */
+    Bitboard getShields(int strength) const;
+
+    /** @brief Return the region of a cell: the connected cells of its owner. */
+    Bitboard getRegion(int cell) const;
+
+    /**
+     * @brief Return the cells reachable from a region by a troop.
+     *
+     * Only the words of the region and around it are computed (see Bitboard::Span).
+     * Not thread-safe: uses the scratch boards of this object.
+     *
+     * @param region   Region (see getRegion()).
+     * @param strength Strength of the troop (0: only the region).
+     * @return The region and, around it, the cells with a weaker shield.
+     */
+    Bitboard getReachable(const Bitboard& region, int strength) const;
+
+private:
+    Bitboard empty_;                      ///< Empty board of the size of the map
+    Bitboard playable_;                   ///< Playable cells
+    std::vector<Bitboard> owners_;        ///< Cells of each player number (0: nobody)
+    std::vector<Bitboard> strengths_;     ///< Cells of each element strength
+
+    // Scratch boards of shieldsOn() and getReachable(), valid on the computed words only
+    mutable Bitboard strong_;             ///< Cells with a strong element
+    mutable Bitboard strongOwned_;        ///< Cells of one player with a strong element
+    mutable Bitboard dilated_;            ///< Dilation of one of the boards above
+    mutable Bitboard shields_;            ///< Cells whose shield is strong
+
+    /** @brief Return the board of a player, added if needed. */
+    Bitboard& owned(int player);
+
+    /**
+     * @brief Compute the shields of some cells (see getShields()) in shields_.
+     * @param strength Strength the shields must reach.
+     * @param span     Words of the computed cells.
+     * @return shields_, only valid on the words of span.
+     */
+    const Bitboard& shieldsOn(int strength, const Bitboard::Span& span) const;
+};
+
+#endif // MAPBITBOARDS_HPP
@@ -0,0 +1,70 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+//------------------------------
+// Rules
+//------------------------------
+#include "Rules/Action.hpp"               // Recorded actions
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <string>                         // std::string
+#include <vector>                         // std::vector
+
+/**
+ * @brief Log of a game: map, seed of the random number generator and actions.
+ *
+ * Replaying the actions on the same map with the same seed gives back the same game.
+ *
+ * Binary format (little endian):
+ *   - "KRPL", version (u8), seed (u32), length of map path (u16), map path
+ *   - number of actions (u32), then for each action its type (u8) followed by:
+ *     - Move/Merge: from x, from y, to x, to y (u16 each)
+ *     - Buy: element letter (u8), source (u8: 0 town, 1 shop), from x, from y, to x, to y (u16 each)
+ *     - Castle: to x, to y (u16 each)
+ *     - EndTurn/Undo: nothing
+ */
+class Replay {
+public:
+    /**
+     * @brief Load a replay from a binary file.
+     * @param path Path of the replay file.
+     * @return Loaded replay.
+     * @throws std::runtime_error if the file can't be read or is malformed.
+     */
+    static Replay load(const std::string& path);
+
+    /**
+     * @brief Create an empty replay.
+     * @param mapFile Path of the map of the game.
+     * @param seed    Seed of the random number generator of the game.
+     */
+    Replay(const std::string& mapFile = "", unsigned int seed = 0);
+
+    /** @brief Append an action played in the game. */
+    void record(const Action& action);
+
+    /**
+     * @brief Save the replay in a binary file.
+     * @param path Path of the replay file.
+     * @throws std::runtime_error if the file can't be written.
+     */
+    void save(const std::string& path) const;
+
+    /** @brief Return the path of the map of the game. */
+    const std::string& getMapFile() const;
+
+    /** @brief Return the seed of the random number generator of the game. */
+    const unsigned int getSeed() const;
+
+    /** @brief Return the recorded actions, in order. */
+    const std::vector<Action>& getActions() const;
+
+private:
+    std::string mapFile_;             ///< Path of the map
+    unsigned int seed_;               ///< Seed of the random number generator
+    std::vector<Action> actions_;     ///< Played actions
+};
+
+#endif // REPLAY_HPP
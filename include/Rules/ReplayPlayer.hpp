@@ -0,0 +1,77 @@
+#ifndef REPLAYPLAYER_HPP
+#define REPLAYPLAYER_HPP
+
+//------------------------------
+// Rules
+//------------------------------
+#include "Rules/Replay.hpp"                       // Log to play back
+
+//------------------------------
+// Widgets
+//------------------------------
+#include "Widgets/GameMap.hpp"                    // Rules engine
+
+//------------------------------
+// Coordinates
+//------------------------------
+#include "SDLWrappers/Coords/Point.hpp"           // Position of the map
+#include "SDLWrappers/Coords/Size.hpp"            // Size of the map
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <memory>                                 // std::unique_ptr
+
+/**
+ * @brief Play back a Replay through GameMap::applyAction().
+ *
+ * The map must be created with the map file and the seed of the replay
+ * (see createMap()), then the actions are played one by one with step()
+ * (e.g. one per tick in the GUI) or all at once with playAll() (headless).
+ */
+class ReplayPlayer {
+public:
+    /**
+     * @brief Create a player for a replay.
+     * @param replay Replay to play back.
+     */
+    explicit ReplayPlayer(const Replay& replay);
+
+    /**
+     * @brief Create the map of the replay, in its initial state.
+     * @param pos  Position of the map.
+     * @param size Size of the map.
+     * @return New GameMap with the map file and the seed of the replay.
+     */
+    std::unique_ptr<GameMap> createMap(const Point& pos, const Size& size) const;
+
+    /**
+     * @brief Play the next action on the map.
+     * @param map Map created by createMap() on which the previous actions have been played.
+     * @return false if every action has already been played.
+     * @throws std::runtime_error if the action is rejected by the rules (desynchronized replay).
+     */
+    const bool step(GameMap& map);
+
+    /**
+     * @brief Play every remaining action on the map.
+     * @param map Map created by createMap() on which the previous actions have been played.
+     * @throws std::runtime_error if an action is rejected by the rules (desynchronized replay).
+     */
+    void playAll(GameMap& map);
+
+    /** @brief Check if every action has been played. */
+    const bool isFinished() const;
+
+    /** @brief Return the number of actions already played. */
+    const size_t getPosition() const;
+
+    /** @brief Return the replay played back. */
+    const Replay& getReplay() const;
+
+private:
+    Replay replay_;                 ///< Replay played back
+    size_t position_ = 0;           ///< Index of the next action
+};
+
+#endif // REPLAYPLAYER_HPP
@@ -0,0 +1,43 @@
+#ifndef ZOBRISTHASH_HPP
+#define ZOBRISTHASH_HPP
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <cstdint>                        // std::uint64_t
+#include <memory>                         // std::shared_ptr
+
+class GameElement;
+
+/**
+ * @brief 64-bit Zobrist hash of the state of a map.
+ *
+ * The hash is the XOR of one key per (cell, owner) and per (cell, element type);
+ * the side to move is added by GameMap::getHash(). PlayableGround toggles its keys
+ * in setOwner() and setElement(), so the hash stays up to date in O(1) per change.
+ *
+ * Keys are derived from (cell index, feature) with a splitmix64 mix of a fixed seed,
+ * so they are identical in every process and need no table sized to the map.
+ */
+class ZobristHash {
+public:
+    /** @brief Key of a cell owned by a player (0 for no owner). */
+    static std::uint64_t ownerKey(int cell, int player);
+
+    /** @brief Key of a cell holding an element (0 for no element). */
+    static std::uint64_t elementKey(int cell, const std::shared_ptr<GameElement>& elt);
+
+    /** @brief Key of the player whose turn it is (0 for nobody). */
+    static std::uint64_t sideKey(int player);
+
+    /** @brief Add or remove a key. */
+    void toggle(std::uint64_t key) { hash_ ^= key; }
+
+    /** @brief Return the current hash. */
+    std::uint64_t get() const { return hash_; }
+
+private:
+    std::uint64_t hash_ = 0;              ///< XOR of the keys of the state
+};
+
+#endif // ZOBRISTHASH_HPP
@@ -0,0 +1,47 @@
+#ifndef RENDERSTATS_HPP
+#define RENDERSTATS_HPP
+
+#include "SDL.h"                            // SDL_Rect
+#include "SDLWrappers/Coords/Size.hpp"      // Size of the target
+
+/**
+ * @brief Counters of the rendering calls, read by the rendering benchmarks.
+ *
+ * Texture and Window count their blits, RenderTargetGuard counts the render
+ * target switches. Rendering is single-threaded, so plain counters are enough.
+ */
+class RenderStats {
+public:
+    /**
+     * @brief Count one SDL_RenderCopy.
+     * @param dest Destination rectangle (nullptr: the whole target).
+     * @param targetSize Size of the target.
+     */
+    static void countBlit(const SDL_Rect* dest, const Size& targetSize) {
+        blits_++;
+        pixels_ += dest ? static_cast<unsigned long>(dest->w) * dest->h
+                        : static_cast<unsigned long>(targetSize.getWidth()) * targetSize.getHeight();
+    }
+
+    /** @brief Count one SDL_SetRenderTarget that changes the target. */
+    static void countTargetSwitch() { targetSwitches_++; }
+
+    /** @brief Return the number of blits since the last reset. */
+    static const unsigned long getBlits() { return blits_; }
+
+    /** @brief Return the number of pixels written by the blits since the last reset. */
+    static const unsigned long getPixels() { return pixels_; }
+
+    /** @brief Return the number of render target switches since the last reset. */
+    static const unsigned long getTargetSwitches() { return targetSwitches_; }
+
+    /** @brief Reset the counters. */
+    static void reset();
+
+private:
+    static unsigned long blits_;            ///< SDL_RenderCopy calls
+    static unsigned long pixels_;           ///< Pixels written by SDL_RenderCopy
+    static unsigned long targetSwitches_;   ///< Effective SDL_SetRenderTarget calls
+};
+
+#endif // RENDERSTATS_HPP
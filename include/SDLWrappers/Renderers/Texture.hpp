@@ -7,6 +7,7 @@
 #include <string>           // std::string
 #include <memory>           // std::shared_ptr, std::weak_ptr, std::enable_shared_from_this
 #include <stdexcept>        // std::runtime_error
+#include <vector>           // std::vector
 
 //------------------------------
 // SDL2 Core & Extensions
@@ -92,6 +93,8 @@ public:
 
     /**
      * @brief Apply color modulation to this texture.
+     *
+     * Cheap when the color doesn't change, so shared textures can be tinted before each blit.
      * @param color New RGB values (alpha preserved).
      * @throws std::runtime_error on SDL error.
      */
@@ -137,6 +140,49 @@ public:
      */
     void fill(const SDL_Color& color) const;
 
+    /**
+     * @brief Replace a part of the texture with a solid color (alpha included, no blending).
+     * @param color Color to fill (includes alpha).
+     * @param rect  Part of the texture to fill.
+     */
+    void fill(const SDL_Color& color, const Rect& rect) const;
+
+    /**
+     * @brief Set the position of the texture in a larger surface it is a tile of.
+     *
+     * Destinations of blits and fills onto the texture are then given in the
+     * coordinates of the surface, and shifted by -origin.
+     * @param origin Top-left corner of the texture in the surface.
+     */
+    void setOrigin(const Point& origin);
+
+    /** @brief Return the position of the texture in the surface it is a tile of. */
+    const Point& getOrigin() const;
+
+    /**
+     * @brief Set the scale at which the surface is drawn onto the texture.
+     *
+     * Destinations are scaled after the shift by -origin. Below 1/2, sources
+     * are drawn from their pre-scaled variant (see getMip()) of the closest
+     * power of two, which is cheaper and not aliased.
+     * @param scale Scale factor, 1 by default.
+     */
+    void setScale(double scale);
+
+    /** @brief Return the scale at which the surface is drawn onto the texture. */
+    const double getScale() const;
+
+    /**
+     * @brief Return the variant of the texture scaled down by 2^level (built at the first call).
+     *
+     * Each level halves the previous one with linear filtering. The variants keep
+     * the color modulation of the texture and are dropped when it is drawn onto.
+     * @param level Level in [1, MAX_MIP_LEVEL], limited by the size of the texture.
+     */
+    Texture& getMip(int level);
+
+    static constexpr int MAX_MIP_LEVEL = 4;  ///< Smallest pre-scaled variant: 1/16
+
     // BlitTarget interface: various overloads to copy from another Texture
     void blit(const std::weak_ptr<Texture>& src) const override;
     void blit(const std::weak_ptr<Texture>& src, const Point& destPos) const override;
@@ -157,6 +203,16 @@ private:
     std::weak_ptr<SDL_Renderer> renderer_;   ///< Renderer used for all draw calls
     Size size_;                              ///< Cached width/height
     bool alpha_;                             ///< True if texture uses alpha blending
+    Point origin_;                           ///< Top-left corner in the surface it is a tile of
+    double scale_ = 1;                       ///< Scale of the surface drawn onto the texture
+    SDL_Color colorMod_{255, 255, 255, 255}; ///< Color modulation (see colorize())
+    mutable std::vector<std::shared_ptr<Texture>> mips_; ///< Pre-scaled variants, by level - 1
+
+    /** @brief Shift and scale a destination given in surface coordinates (nullptr is kept). */
+    const SDL_Rect* toLocal(const SDL_Rect* destRect, SDL_Rect& local) const;
+
+    /** @brief Copy a source onto the texture, from its variant matching scale_. */
+    void render(Texture& src, const SDL_Rect* srcRect, const SDL_Rect* destRect) const;
 
     // Internal convenience blit implementations taking raw SDL_Rects
     void blit(const std::weak_ptr<Texture>& src, const SDL_Rect* srcRect, const SDL_Rect* destRect) const;
@@ -0,0 +1,108 @@
+#ifndef TILECACHE_HPP
+#define TILECACHE_HPP
+
+//------------------------------
+// Rendering Abstractions
+//------------------------------
+#include "SDLWrappers/Renderers/Texture.hpp"          // Texture of a tile
+#include "SDLWrappers/Coords/Rect.hpp"                // Integer rectangle type
+#include "SDLWrappers/Coords/Size.hpp"                // Width/height pair
+
+//------------------------------
+// STL & Utilities
+//------------------------------
+#include <memory>                                     // std::shared_ptr, std::weak_ptr
+#include <list>                                       // LRU order
+#include <unordered_map>                              // Tiles by index
+#include <vector>                                     // std::vector
+
+struct SDL_Renderer;
+
+/**
+ * @brief Large render target split into fixed-size tiles, kept in a LRU cache.
+ *
+ * Only the tiles that are displayed get a texture, so the memory does not grow
+ * with the surface. When the cache is full, the least recently used tile gives
+ * its texture to the new one and has to be redrawn when it is needed again.
+ *
+ * The texture of a tile has its origin (see Texture::setOrigin()) at the top-left
+ * corner of the tile, so it is drawn in the coordinates of the whole surface.
+ * At level n, the surface is drawn at the scale 1/2^n (see Texture::setScale()):
+ * a tile covers 2^n times more of the surface with the same texture.
+ */
+class TileCache {
+public:
+    static constexpr int TILE_SIZE = 512;              ///< Width and height of a tile in pixels
+    static constexpr size_t DEFAULT_CAPACITY = 48;     ///< Tiles kept by default (48 MB)
+    static constexpr int MAX_LEVEL = 3;                ///< Smallest scale of the surface: 1/8
+
+    /**
+     * @brief A tile of the surface.
+     */
+    struct Tile {
+        Rect rect;                                     ///< Part of the surface (clipped to it)
+        Rect source;                                   ///< Part of the texture holding rect
+        std::shared_ptr<Texture> texture;              ///< Texture of the tile
+        bool dirty = true;                             ///< True if the texture must be redrawn
+        bool animated = false;                         ///< True if the content changes every frame
+    };
+
+    /**
+     * @param renderer    Renderer of the textures.
+     * @param surfaceSize Size of the whole surface.
+     * @param capacity    Maximum number of tiles with a texture.
+     */
+    TileCache(const std::weak_ptr<SDL_Renderer>& renderer, const Size& surfaceSize, size_t capacity = DEFAULT_CAPACITY);
+
+    /** @brief Return the size of the whole surface. */
+    const Size& getSurfaceSize() const;
+
+    /**
+     * @brief Change the scale of the tiles, dropping them if it changes.
+     * @param level Level in [0, MAX_LEVEL], drawn at the scale 1/2^level.
+     */
+    void setLevel(int level);
+
+    /** @brief Return the level of the tiles. */
+    const int getLevel() const;
+
+    /**
+     * @brief Return the tiles overlapping an area, as a rectangle of tile coordinates.
+     * @param area Area of the surface.
+     * @return Columns and rows of the tiles (empty if the area is outside).
+     */
+    Rect getTilesIn(const Rect& area) const;
+
+    /**
+     * @brief Return a tile, with a texture, and mark it as the most recently used.
+     *
+     * The reference stays valid until the next call (it may evict a tile).
+     * @param tx, ty Coordinates of the tile.
+     */
+    Tile& acquire(int tx, int ty);
+
+    /** @brief Return the parts of the surface covered by the tiles with a texture. */
+    std::vector<Rect> getAreas() const;
+
+    /** @brief Mark every tile to be redrawn. */
+    void invalidate();
+
+    /** @brief Mark the tiles overlapping an area to be redrawn. */
+    void invalidate(const Rect& area);
+
+private:
+    std::weak_ptr<SDL_Renderer> renderer_;             ///< Renderer of the textures
+    Size surfaceSize_;                                 ///< Size of the whole surface
+    int level_ = 0;                                    ///< Level of the tiles
+    int span_ = TILE_SIZE;                             ///< Part of the surface covered by a tile (TILE_SIZE * 2^level_)
+    int cols_;                                         ///< Number of tile columns
+    int rows_;                                         ///< Number of tile rows
+    size_t capacity_;                                  ///< Maximum number of tiles
+
+    std::unordered_map<int, Tile> tiles_;              ///< Tiles with a texture, by index (ty * cols_ + tx)
+    std::list<int> lru_;                               ///< Indexes of tiles, most recently used first
+    std::unordered_map<int, std::list<int>::iterator> lruPos_; ///< Position of each index in lru_
+    std::vector<std::shared_ptr<Texture>> freeTextures_; ///< Textures of the tiles dropped by setLevel()
+};
+
+#endif // TILECACHE_HPP
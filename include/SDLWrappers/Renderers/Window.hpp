@@ -36,6 +36,19 @@ struct SDLWindowDeleter {
     }
 };
 
+/**
+ * @brief Custom deleter for SDL_Surface (offscreen windows).
+ */
+struct SDLSurfaceDeleter {
+    /**
+     * @brief Free the SDL_Surface if it exists.
+     * @param surface Pointer to the SDL_Surface to free.
+     */
+    void operator()(SDL_Surface* surface) const {
+        if (surface) SDL_FreeSurface(surface);
+    }
+};
+
 /**
  * @brief Main application window for the Konkr game.
  *
@@ -51,6 +64,14 @@ public:
      */
     Window(const char* title, const Size& size);
 
+    /**
+     * @brief Create an offscreen window: a software renderer drawing into a memory surface.
+     *
+     * Needs neither a display nor a GPU (benchmarks on CI machines).
+     * @param size Size of the surface.
+     */
+    explicit Window(const Size& size);
+
     /**
      * @brief Destructor cleans up renderer and window resources.
      */
@@ -118,6 +139,9 @@ private:
     ///< SDL_Window wrapped in unique_ptr with custom deleter
     std::unique_ptr<SDL_Window, SDLWindowDeleter> SDLWindow_;
 
+    ///< Surface drawn by the software renderer of an offscreen window (freed after the renderer)
+    std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> surface_;
+
     ///< Renderer associated with the window
     std::shared_ptr<SDL_Renderer> renderer_;
 
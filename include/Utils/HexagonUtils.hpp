@@ -7,6 +7,8 @@
 #include <cmath>    // std::round, std::abs, std::sqrt
 #include <utility>  // std::pair
 #include <cstdlib>  // general utilities (not strictly required here but included)
+#include <cstdint>  // std::int64_t
+#include <span>     // std::span
 
 /**
  * @namespace HexagonUtils
@@ -26,6 +28,8 @@ namespace HexagonUtils
     const double PI2  = 2 * PI;
     /// Pi over two (90 degrees)
     const double PI05 = PI / 2.0;
+    /// Square root of 3 (ratio between the widths of the hexagons and their radius)
+    constexpr double SQRT3 = 1.73205080756887729353;
 
     /**
      * @brief Round floating-point axial hex coordinates to the nearest hex.
@@ -67,7 +71,7 @@ namespace HexagonUtils
      * @return Rounded axial coordinates (q, r).
      */
     inline std::pair<int, int> pixelToAxial(double x, double y, double hexSize) {
-        double q = ((std::sqrt(3) / 3.0 * x) - (1.0 / 3.0 * y)) / hexSize;
+        double q = ((SQRT3 / 3.0 * x) - (1.0 / 3.0 * y)) / hexSize;
         double r = (2.0 / 3.0 * y) / hexSize;
         return hexRound(q, r);
     }
@@ -83,7 +87,7 @@ namespace HexagonUtils
      * @return Pixel coordinates (x, y).
      */
     inline std::pair<int, int> axialToPixel(double q, double r, double hexSize) {
-        int x = static_cast<int>(hexSize * std::sqrt(3) * (q + r / 2.0));
+        int x = static_cast<int>(hexSize * SQRT3 * (q + r / 2.0));
         int y = static_cast<int>(hexSize * (3.0 / 2.0) * r);
         return {x, y};
     }
@@ -97,7 +101,7 @@ namespace HexagonUtils
      * @param y Offset row index.
      * @return Axial coordinates (q, r).
      */
-    inline std::pair<int, int> offsetToAxial(int x, int y) {
+    constexpr std::pair<int, int> offsetToAxial(int x, int y) {
         int q = x - (y - (y & 1)) / 2;
         int r = y;
         return {q, r};
@@ -112,7 +116,7 @@ namespace HexagonUtils
      * @param r Axial r coordinate.
      * @return Offset coordinates (x, y).
      */
-    inline std::pair<int, int> axialToOffset(int q, int r) {
+    constexpr std::pair<int, int> axialToOffset(int q, int r) {
         int x = q + ((r - (r & 1)) / 2);
         int y = r;
         return {x, y};
@@ -148,6 +152,26 @@ namespace HexagonUtils
         return axialToOffset(q, r);
     }
 
+    //--------------------------------------------------------------------------
+    // Neighbors
+    //--------------------------------------------------------------------------
+    /// Offsets (dx, dy) of the 6 neighbors of a cell of an odd row, in the order of Cell::setNeighbors()
+    constexpr int ODD_ROW_NEIGHBORS[6][2]  = { {0, -1}, {-1, 0}, {0, 1}, {1, 1}, {1, 0}, {1, -1} };
+    /// Offsets (dx, dy) of the 6 neighbors of a cell of an even row, in the same order
+    constexpr int EVEN_ROW_NEIGHBORS[6][2] = { {-1, -1}, {-1, 0}, {-1, 1}, {0, 1}, {1, 0}, {0, -1} };
+
+    /**
+     * @brief Return the offset from a cell to one of its neighbors.
+     *
+     * @param y         Offset row index of the cell (the offsets depend on its parity).
+     * @param direction Index of the neighbor, from 0 to 5.
+     * @return Offset (dx, dy) to add to the coordinates of the cell.
+     */
+    constexpr std::pair<int, int> neighborOffset(int y, int direction) {
+        const auto& offset = (y & 1) ? ODD_ROW_NEIGHBORS[direction] : EVEN_ROW_NEIGHBORS[direction];
+        return {offset[0], offset[1]};
+    }
+
     /**
      * @brief Convert the “inner radius” (apothem) to the outer radius of the hexagon.
      *
@@ -157,7 +181,7 @@ namespace HexagonUtils
      * @return Inner radius (center to edge midpoint).
      */
     inline double innerToRadius(double radius) {
-        return radius * 2.0 / std::sqrt(3);
+        return radius * 2.0 / SQRT3;
     }
 
     /**
@@ -167,8 +191,127 @@ namespace HexagonUtils
      * @return Outer radius (center to corner).
      */
     inline double radiusToInner(double innerRadius) {
-        return innerRadius * std::sqrt(3) / 2.0;
+        return innerRadius * SQRT3 / 2.0;
     }
+
+    //--------------------------------------------------------------------------
+    // Batch conversions
+    //--------------------------------------------------------------------------
+    /// Name of the instruction set of the batch conversions ("SSE2" or "scalar")
+    extern const char* const BATCH_ISA;
+
+    /**
+     * @brief Convert arrays of axial coordinates to pixels, several at a time.
+     *
+     * Gives exactly the results of axialToPixel() on each element (same
+     * double operations, in the same order).
+     *
+     * @param qs, rs   Axial coordinates.
+     * @param hexSize  Radius of the hexagon.
+     * @param xs, ys   Output pixel coordinates (same size as the inputs).
+     */
+    void axialToPixel(std::span<const int> qs, std::span<const int> rs, double hexSize,
+                      std::span<int> xs, std::span<int> ys);
+
+    /**
+     * @brief Convert arrays of offset coordinates to pixels, several at a time.
+     *
+     * Gives exactly the results of offsetToPixel() on each element.
+     *
+     * @param cols, rows Offset coordinates.
+     * @param hexSize    Radius of the hexagon.
+     * @param xs, ys     Output pixel coordinates (same size as the inputs).
+     */
+    void offsetToPixel(std::span<const int> cols, std::span<const int> rows, double hexSize,
+                       std::span<int> xs, std::span<int> ys);
+
+    /**
+     * @brief Convert arrays of pixels to axial coordinates, several at a time.
+     *
+     * Gives exactly the results of pixelToAxial() on each element, rounding
+     * included (pixels must stay within the int range once divided by hexSize).
+     *
+     * @param xs, ys   Pixel coordinates.
+     * @param hexSize  Radius of the hexagon.
+     * @param qs, rs   Output axial coordinates (same size as the inputs).
+     */
+    void pixelToAxial(std::span<const int> xs, std::span<const int> ys, double hexSize,
+                      std::span<int> qs, std::span<int> rs);
+
+    /**
+     * @brief Hexagon layout of a given radius, with its constants computed once.
+     *
+     * pixelToOffset() only uses integers: the axial coordinates are computed in
+     * fixed point (FRACTION_BITS bits after the point) and rounded like hexRound().
+     * It is meant for hit tests, which run on every mouse motion.
+     */
+    class Geometry {
+    public:
+        static constexpr int FRACTION_BITS = 32;                       ///< Bits after the point
+        static constexpr std::int64_t ONE = std::int64_t{1} << FRACTION_BITS; ///< 1 in fixed point
+
+        /** @param hexSize Radius of the hexagon (0: every pixel is in the hexagon (0, 0)). */
+        constexpr explicit Geometry(double hexSize = 0)
+            : radius_(hexSize),
+              qx_(hexSize > 0 ? toFixed(SQRT3 / 3.0 / hexSize) : 0),
+              qy_(hexSize > 0 ? toFixed(1.0 / 3.0 / hexSize) : 0),
+              ry_(hexSize > 0 ? toFixed(2.0 / 3.0 / hexSize) : 0),
+              stepX_(hexSize * SQRT3),
+              stepY_(hexSize * 1.5)
+        {}
+
+        /** @brief Return the radius of the hexagons. */
+        constexpr double getRadius() const { return radius_; }
+
+        /** @brief Return the horizontal distance between two hexagons of a row. */
+        constexpr double getStepX() const { return stepX_; }
+
+        /** @brief Return the vertical distance between two rows. */
+        constexpr double getStepY() const { return stepY_; }
+
+        /**
+         * @brief Convert pixel coordinates to offset grid coordinates, in fixed point.
+         * @param x, y Position in pixels, relative to the center of the hexagon (0, 0).
+         * @return Offset coordinates (x, y).
+         */
+        constexpr std::pair<int, int> pixelToOffset(int x, int y) const {
+            std::int64_t q = qx_ * x - qy_ * y;
+            std::int64_t r = ry_ * y;
+            std::int64_t s = -q - r;
+
+            // Round the cube coordinates and fix the one with the largest error
+            std::int64_t qRound = round(q);
+            std::int64_t rRound = round(r);
+            std::int64_t sRound = round(s);
+            std::int64_t qDiff = abs(qRound * ONE - q);
+            std::int64_t rDiff = abs(rRound * ONE - r);
+            std::int64_t sDiff = abs(sRound * ONE - s);
+            if (qDiff > rDiff && qDiff > sDiff)
+                qRound = -rRound - sRound;
+            else if (rDiff > sDiff)
+                rRound = -qRound - sRound;
+
+            return axialToOffset(static_cast<int>(qRound), static_cast<int>(rRound));
+        }
+
+    private:
+        double radius_;                                                ///< Radius of the hexagons
+        std::int64_t qx_, qy_, ry_;                                    ///< Fixed point factors of pixelToAxial()
+        double stepX_, stepY_;                                         ///< Distances between the centers
+
+        static constexpr std::int64_t toFixed(double value) {
+            return static_cast<std::int64_t>(value * ONE + 0.5);
+        }
+
+        /// Nearest integer of a fixed point value (halves rounded up)
+        static constexpr std::int64_t round(std::int64_t value) {
+            return (value + ONE / 2) >> FRACTION_BITS;
+        }
+
+        static constexpr std::int64_t abs(std::int64_t value) {
+            return value < 0 ? -value : value;
+        }
+    };
 }
 
 #endif // HEXAGONUTILS_HPP
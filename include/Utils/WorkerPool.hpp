@@ -0,0 +1,76 @@
+#ifndef WORKERPOOL_HPP
+#define WORKERPOOL_HPP
+
+//------------------------------
+// Standard Library
+//------------------------------
+#include <atomic>                         // std::atomic
+#include <condition_variable>             // std::condition_variable
+#include <cstdint>                        // std::uint64_t
+#include <functional>                     // std::function
+#include <mutex>                          // std::mutex
+#include <thread>                         // std::thread
+#include <vector>                         // std::vector
+
+/**
+ * @brief Threads kept waiting for batches of jobs.
+ *
+ * The threads are started once, then each run() hands its jobs out to them and
+ * to the calling thread (an atomic counter) and returns when every job is done.
+ * This avoids starting and joining threads for each batch.
+ */
+class WorkerPool {
+public:
+    /**
+     * @brief Job of a batch.
+     * @param job    Index of the job in its batch.
+     * @param worker Index of the thread running it (0: the calling thread),
+     *               below getSize(), to use a scratch buffer per thread.
+     */
+    using Job = std::function<void(int job, int worker)>;
+
+    /**
+     * @brief Start the threads of the pool.
+     * @param nbWorkers Threads running the jobs, counting the calling thread (at least 1).
+     */
+    explicit WorkerPool(int nbWorkers);
+
+    /** @brief Wait for the threads to end. */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /** @brief Return the number of threads running the jobs, counting the calling thread. */
+    const int getSize() const;
+
+    /**
+     * @brief Run a batch of jobs on the threads and wait for its end.
+     *
+     * Jobs must not throw. Only one batch runs at a time.
+     *
+     * @param nbJobs Number of jobs.
+     * @param job    Function called once for each job.
+     */
+    void run(int nbJobs, const Job& job);
+
+private:
+    /** @brief Loop of a thread: wait for a batch, run its jobs. */
+    void work(int worker);
+
+    /** @brief Run the jobs of the current batch not taken yet. */
+    void runJobs(int worker);
+
+    std::vector<std::thread> threads_;    ///< Threads of the pool (workers 1 to N - 1)
+    std::mutex mutex_;                    ///< Guards the batch and the counters
+    std::condition_variable wake_;        ///< Notified when a batch starts or the pool stops
+    std::condition_variable done_;        ///< Notified when the threads are done with a batch
+    const Job* job_ = nullptr;            ///< Function of the current batch
+    int nbJobs_ = 0;                      ///< Number of jobs of the current batch
+    std::atomic<int> nextJob_{0};         ///< Next job of the current batch to take
+    int running_ = 0;                     ///< Threads still on the current batch
+    std::uint64_t batch_ = 0;             ///< Number of the current batch
+    bool stopping_ = false;               ///< True when the pool is destroyed
+};
+
+#endif // WORKERPOOL_HPP
@@ -20,6 +20,7 @@
 #include "SDLWrappers/Coords/Size.hpp"                // Width/height pair
 #include "SDLWrappers/Font.hpp"                       // Text rendering support
 #include "SDLWrappers/Renderers/BlitTarget.hpp"       // Interface for render targets
+#include "SDLWrappers/Renderers/TileCache.hpp"        // Tiles of the drawn map
 
 //------------------------------
 // Game Elements
@@ -36,13 +37,30 @@
 #include "Displayers/Displayer.hpp"                   // Abstract renderable interface
 #include "Displayers/TreasuryDisplayer.hpp"           // Shows player treasury info
 
+//------------------------------
+// Rules
+//------------------------------
+#include "Rules/Action.hpp"                           // Legal actions of a player
+#include "Rules/Replay.hpp"                           // Log of the played actions
+#include "Rules/ZobristHash.hpp"                      // Incremental hash of the state
+#include "Rules/MapBitboards.hpp"                     // Owners and elements as bitboards
+
+//------------------------------
+// Utilities
+//------------------------------
+#include "Utils/HexagonUtils.hpp"                     // Hexagon layout
+#include "Utils/WorkerPool.hpp"                       // Threads of updateAllIncomes
+
 //------------------------------
 // STL & Utilities
 //------------------------------
+#include <cstdint>                                    // std::uint64_t
+#include <map>                                        // std::map
 #include <memory>                                     // std::shared_ptr, std::weak_ptr
 #include <utility>                                    // std::pair
 #include <optional>                                   // std::optional
 #include <vector>                                     // std::vector
+#include <span>                                       // std::span
 #include <algorithm>                                  // std algorithms
 #include <random>                                     // Random number generator
 #include <unordered_map>                              // Hash map container
@@ -56,8 +74,8 @@
  */
 class GameMap : public HexagonGrid<std::shared_ptr<Cell>>, public Displayer {
 public:
-    /** @brief Load shared resources (textures, fonts) needed by all GameMap instances. */
-    static void init();
+    /** @brief Draw a seed for the random number generator of a new game. */
+    static unsigned int randomSeed();
 
     /**
      * @brief Factory: create a Cell subclass based on a character code.
@@ -80,8 +98,9 @@ public:
      * @param pos     Top-left corner in world coords.
      * @param size    Pixel dimensions.
      * @param mapFile Path to map description file.
+     * @param seed    Seed of the random number generator of the game (bandits, camps).
      */
-    GameMap(const Point& pos, const Size size, const std::string mapFile);
+    GameMap(const Point& pos, const Size size, const std::string mapFile, unsigned int seed = randomSeed());
 
     /** @brief Adjust the displayed size proportionally when the window is resized. */
     void setProportionalSize(const Size size);
@@ -92,7 +111,11 @@ public:
     /** @brief Move the map to a new top-left position. */
     void setPos(const Point& pos) override;
 
-    /** @brief Redraw all map components (terrain, elements, overlays). */
+    /**
+     * @brief Redraw the changed map components (terrain, elements, overlays) of the part visible at the last display().
+     *
+     * The other tiles are redrawn when they become visible.
+     */
     void refresh() const;
 
     /** @brief Return the current player's maximum treasury (for UI display). */
@@ -143,8 +166,70 @@ public:
     /** @brief Save map data (cell types, elements) into a file. */
     void saveMap() const;
 
+    /** @brief Return the seed of the random number generator of this game. */
+    const unsigned int getSeed() const;
+
+    /** @brief Return the players still in game. */
+    const std::vector<std::weak_ptr<Player>>& getPlayers() const;
+
+    /** @brief Return the player whose turn it is (nullptr if none). */
+    std::shared_ptr<Player> getCurrentPlayer() const;
+
+    /**
+     * @brief Enumerate every legal action of a player.
+     *
+     * Moves, merges, purchases per town region, castle placements and end of turn.
+     * Only the player whose turn it is has legal actions. The buffer is cleared
+     * and refilled, its capacity is reused; no cell or display state is modified.
+     *
+     * @param player Player to enumerate for.
+     * @param moves  Output buffer.
+     */
+    void generateMoves(const std::weak_ptr<Player>& player, std::vector<Action>& moves);
+
+    /**
+     * @brief Play an action of the current player through the same rules as the mouse.
+     * @param action Action to play (usually produced by generateMoves()).
+     * @return true if the action changed the game.
+     */
+    const bool applyAction(const Action& action);
+
+    /** @brief Return the log of the actions played since the start of the game. */
+    const Replay& getReplay() const;
+
+    /**
+     * @brief Return the Zobrist hash of the state: owners, element types and player to move.
+     *
+     * Maintained incrementally, so equal states can be compared (or stored in a
+     * transposition table) in O(1) without walking the grids.
+     */
+    const std::uint64_t getHash() const;
+
+    /** @brief Compute the same hash as getHash() from scratch (to check it). */
+    const std::uint64_t computeHash() const;
+
+    /** @brief Return the owners and elements of the cells as bitboards, kept up to date like getHash(). */
+    const MapBitboards& getBitboards() const;
+
+    /**
+     * @brief Set the number of threads sharing the regions of updateAllIncomes().
+     *
+     * The threads are started once and kept by the map. At each update, the regions
+     * of a large map are posted to them, then their incomes are given to the towns
+     * in the order of the regions: results are the same with any number of threads.
+     *
+     * @param nbThreads Number of threads (1: serial, default).
+     */
+    void setRegionThreads(int nbThreads);
+
 private:
-    static std::mt19937 gen_;                                     ///< Random number generator
+    friend class RulesBench;                                      ///< Times the private steps of the rules
+
+    unsigned int seed_;                                           ///< Seed of the random number generator
+    std::mt19937 gen_;                                            ///< Random number generator of the game
+    Replay replay_;                                               ///< Actions played since the start of the game
+    std::shared_ptr<ZobristHash> hash_;                           ///< Hash of the cells, rebuilt by updateNeighbors()
+    std::shared_ptr<MapBitboards> bitboards_;                     ///< Bitboards of the cells, rebuilt by updateNeighbors()
 
     double ratio_ = 0;                                            ///< Scale factor for drawing
 
@@ -152,7 +237,11 @@ private:
     std::vector<std::weak_ptr<Troop>> movedTroopsSave_;           ///< Saves of moved troops for undo
     int nbUndos_ = 0;
 
-    Point selectedCellPos_;
+    Point selectedCellPos_;                                       ///< Grid coords under the mouse (may be out of the grid)
+    std::optional<std::pair<int, int>> hoveredCell_;              ///< Grid coords of the last hover update
+    std::uint64_t hoveredHash_ = 0;                               ///< State hash of the last hover update
+    HexagonUtils::Geometry geometry_;                             ///< Layout of the hexagons, for hit tests
+    Point selectedTroopCellPos_;                                  ///< Grid coords of selectedTroopCell_
     std::weak_ptr<PlayableGround> selectedCell_;                  ///< Currently selected ground cell
     std::weak_ptr<Town> townToShowTreasury_;                      ///< Town whose treasury is visible
     std::weak_ptr<Camp> campToShowTreasury_;                      ///< Camp whose treasury is visible
@@ -168,9 +257,50 @@ private:
     std::unordered_set<std::shared_ptr<PlayableGround>> potentialTownCells_; ///< Valid town placement cells
     int selectedPlayerNum_ = 0;                                   ///< Index of current player
 
-    Size calcSize_;                                               ///< Size of calculation overlay
-    std::shared_ptr<Texture> calc_ = nullptr;                     ///< Texture for overlays
+    Size calcSize_;                                               ///< Size of the drawn map in pixels (before ratio_)
+    std::shared_ptr<TileCache> tiles_ = nullptr;                  ///< Tiles of the drawn map, redrawn when dirty
+    mutable Rect viewport_;                                       ///< Part of the drawn map visible on the target, redrawn by refresh()
+    mutable std::vector<std::uint64_t> drawnStates_;              ///< Display state of each cell (y * width + x) when it was last drawn
+    mutable bool changed_ = true;                                 ///< True if cells may have changed since the last markChangedTiles()
     bool gameFinished_ = false;                                   ///< Game-over flag
+    std::unique_ptr<WorkerPool> regionWorkers_ = nullptr;         ///< Threads sharing the regions of updateAllIncomes() (null: serial)
+
+    /// Troop strengths of the cached reachable sets (0 for castles, up to heroes)
+    static constexpr int REACHABLE_STRENGTHS = 5;
+
+    /// Region of getReachable(), and its reachable sets
+    struct ReachableRegion {
+        Bitboard cells;                                           ///< Cells of the region
+        Bitboard sets[REACHABLE_STRENGTHS];                       ///< Reachable cells of each strength (no words: not computed)
+    };
+
+    Bitboard reachable_;                                          ///< Cells shown as reachable
+    std::uint64_t reachableHash_ = 0;                             ///< State of the cached regions
+    std::vector<ReachableRegion> reachableRegions_;               ///< Cached regions
+
+    /// Connected cells of one owner, flooded by updateAllIncomes()
+    struct IncomesRegion {
+        size_t begin = 0;                                         ///< First of its cells in incomesRegionCells_
+        size_t end = 0;                                           ///< End of its cells in incomesRegionCells_
+        std::vector<int> townCells;                               ///< Cell index of each of its towns
+        std::vector<int> incomes;                                 ///< Income of each of its towns
+    };
+
+    // Scratch buffers of generateMoves (reused between calls)
+    std::vector<std::shared_ptr<PlayableGround>> movesGrounds_;   ///< PlayableGround of each cell index
+    std::vector<int> movesRegions_;                               ///< Region id of each cell index (-1 if none)
+    std::vector<int> movesMarks_;                                 ///< Last region that reached a border cell
+    std::vector<int> movesRegionCells_;                           ///< Cells of the current region
+    std::vector<std::pair<int, int>> movesBorderCells_;           ///< Border cells of the current region and their shield
+
+    // Scratch buffers of updateAllIncomes (reused between calls)
+    std::vector<PlayableGround*> incomesGrounds_;                 ///< PlayableGround of each cell index (not owned, set by each call)
+    std::vector<int> incomesRegions_;                             ///< Region id of each cell index (-1 if none)
+    std::vector<int> incomesRegionCells_;                         ///< Cells of every region, region after region
+    std::vector<int> incomesDistances_;                           ///< Distance of each cell index to the nearest town of its region
+    std::vector<int> incomesNearest_;                             ///< Nearest town of each cell index (in the towns of its region)
+    std::vector<std::vector<int>> incomesQueues_;                 ///< Cells of a region by distance to its towns, for each worker
+    std::vector<IncomesRegion> incomesRegionList_;                ///< Regions of the last updateAllIncomes(), by id
 
     /**
      * @brief Internal constructor that unifies both creation paths.
@@ -178,18 +308,81 @@ private:
      * @param size     Display size.
      * @param gridSize Grid dimensions.
      * @param mapFile  Optional file path (empty for manual grid).
+     * @param seed     Seed of the random number generator.
      */
-    GameMap(const Point& pos, const Size size, const std::pair<int, int>& gridSize, const std::string mapFile);
+    GameMap(const Point& pos, const Size size, const std::pair<int, int>& gridSize, const std::string mapFile, unsigned int seed);
 
-    /** @brief Load map data (cell types, elements) from a file. */
+    /** @brief Load map data (cell types, elements) from a file (ASCII, or binary, see BinaryMap). */
     void loadMap(const std::string& mapFile);
 
+    /** @brief Load map data from a binary map file. */
+    void loadBinaryMap(const std::string& mapFile, std::map<int, std::shared_ptr<Player>>& players);
+
+    /**
+     * @brief Compute the pixel positions (centers) of cells, in one batch.
+     * @param xs, ys Cell coordinates.
+     * @return Position of each cell.
+     */
+    std::vector<Point> getCellPositions(std::span<const int> xs, std::span<const int> ys) const;
+
+    /**
+     * @brief Create a cell, its owner and its element from their letters.
+     * @param x, y     Cell coordinates.
+     * @param pos      Position of the cell (see getCellPositions()).
+     * @param cellType Letter of the cell.
+     * @param eltType  Letter of the element.
+     * @param players  Players created so far, by number.
+     */
+    void loadCell(int x, int y, const Point& pos, char cellType, char eltType, std::map<int, std::shared_ptr<Player>>& players);
+
     /** @brief Determine grid dimensions by reading the map file. */
     std::pair<int,int> getSizeOfMapFile(const std::string& mapFile);
 
-    /** @brief Generate textures for calculation overlays. */
+    /** @brief Compute the size of the drawn map and create its tiles. */
     void createCalcs();
 
+    /** @brief Note that cells may be drawn differently, so that the next display() looks for the tiles to redraw. */
+    void invalidate();
+
+    /**
+     * @brief Mark the cached tiles around the cells whose display state changed to be redrawn.
+     *
+     * A changed cell redraws its neighbors too, as its sprites overflow on them.
+     */
+    void markChangedTiles() const;
+
+    /**
+     * @brief Summary of everything drawn for a cell (ground, owner, element, selection, treasury).
+     * @param cell Cell to summarize.
+     * @return Value changing whenever the drawing of the cell changes.
+     */
+    std::uint64_t getDisplayState(const std::shared_ptr<Cell>& cell) const;
+
+    /**
+     * @brief Compute the part of the drawn map visible on a target, from pos_ and ratio_.
+     * @param targetSize Size of the target the map is displayed on.
+     * @return Visible part in pixels of the drawn map (empty if the map is off-screen).
+     */
+    Rect computeViewport(const Size& targetSize) const;
+
+    /**
+     * @brief Return the cells overlapping an area of the drawn map, widened by the sprites overflowing their hexagon.
+     * @param area Area of the drawn map.
+     * @return Columns and rows of the cells (empty if the area is outside).
+     */
+    Rect getCellsIn(const Rect& area) const;
+
+    /** @brief Call f on each cell overlapping an area of the drawn map, row by row. */
+    template<typename F>
+    void forEachCellIn(const Rect& area, F&& f) const;
+
+    /**
+     * @brief Redraw every layer of a tile, and note whether it is animated.
+     * @param tile Tile to redraw.
+     * @param area Part of the tile to redraw, if only the animations must be updated.
+     */
+    void renderTile(TileCache::Tile& tile, const std::optional<Rect>& area = std::nullopt) const;
+
     /** @brief Refresh the visual highlight on the selected cell. */
     void updateSelectedCell();
 
@@ -229,6 +422,44 @@ private:
     /** @brief Count treasures in cells owned by the current player. */
     std::unordered_map<std::shared_ptr<PlayableGround>, int> getTreasuresOfCurrentPlayers();
 
+    /** @brief Count treasures of each region of a player, keyed by one town cell of the region. */
+    std::unordered_map<std::shared_ptr<PlayableGround>, int> getTreasuresOfPlayer(const std::weak_ptr<Player>& player);
+
+    /** @brief Pay a purchase with the towns of the region of a cell. */
+    void payPurchase(const std::shared_ptr<PlayableGround>& cell, int cost);
+
+    /**
+     * @brief Index of a neighbor of a cell (see HexagonUtils::neighborOffset()), in the same order as updateNeighbors().
+     * @param index     Index of the cell (y * width + x).
+     * @param direction Neighbor direction in [0, 6).
+     * @return Index of the neighbor or -1 if out of the grid.
+     */
+    const int getNeighborIndex(int index, int direction) const;
+
+    /** @brief Append the targets reachable from a region with a given strength. */
+    void generateTargets(std::vector<Action>& moves, Action::Type type, int from, int strength, char letter);
+
+    /**
+     * @brief Return the cells reachable from the region of a cell by a given strength.
+     *
+     * The region itself and, if strength > 0, the cells around it with a weaker
+     * shield. Computed on the bitboards (see MapBitboards::getReachable()), then
+     * cached per region and strength until the state (see getHash()) changes.
+     *
+     * @param cell     Index of a cell of the region.
+     * @param strength Strength of the troop, from 0 (castle) to REACHABLE_STRENGTHS - 1.
+     */
+    const Bitboard& getReachable(int cell, int strength);
+
+    /** @brief Show the cells reachable from the region of a ground, with those already shown. */
+    void showReachable(const std::shared_ptr<PlayableGround>& pg, int strength);
+
+    /** @brief Hide every reachable cell. */
+    void clearReachable();
+
+    /** @brief Check if a cell index is shown as reachable (where a troop may be dropped). */
+    const bool isReachable(int cell) const;
+
     /** @brief Place a new castle on a ground cell, if legal. */
     const bool placeCastle(const std::weak_ptr<Castle>& castle, const std::weak_ptr<PlayableGround>& to);
 
@@ -245,6 +476,29 @@ private:
     void updateIncomes(std::weak_ptr<Player>& player);
     void updateIncomes(std::shared_ptr<Player>& player);
 
+    /**
+     * @brief Update the incomes of every player at once, as updateIncomes() on each.
+     *
+     * One sweep of the grid floods the regions: a region with a single town gives
+     * it the income of all its cells. In a region with several towns, a flood from
+     * all of them finds the nearest town of each cell; only the cells as near to
+     * two towns search it on their own (PlayableGround::getNearestTown() breaks the tie).
+     * Regions are independent of each other: they are shared between threads on
+     * large maps (see setRegionThreads()), towns and deficits are updated afterwards.
+     */
+    void updateAllIncomes();
+
+    /**
+     * @brief Compute the incomes of the towns of one region of updateAllIncomes().
+     *
+     * Only reads the cells and elements outside the region, and changes neither
+     * towns nor the display: safe to run on several regions at once.
+     *
+     * @param region Id of the region (index in incomesRegionList_).
+     * @param queue  Scratch buffer of the flood from the towns.
+     */
+    void updateRegionIncomes(int region, std::vector<int>& queue);
+
     /** @brief Save copy of map to undo. */
     void save();
 
@@ -259,12 +513,12 @@ private:
     void onMouseMotion(SDL_Event& event);
     void onMouseButtonUp(SDL_Event& event);
 
-    // Rendering helpers
-    void refreshIslands() const;
-    void refreshPlates() const;
-    void refreshSelectables() const;
-    void refreshFences() const;
-    void refreshElements() const;
+    // Rendering helpers, drawing the cells overlapping an area of the drawn map
+    void refreshIslands(const std::shared_ptr<Texture>& target, const Rect& area) const;
+    void refreshPlates(const std::shared_ptr<Texture>& target, const Rect& area) const;
+    void refreshSelectables(const std::shared_ptr<Texture>& target, const Rect& area) const;
+    void refreshFences(const std::shared_ptr<Texture>& target, const Rect& area) const;
+    bool refreshElements(const std::shared_ptr<Texture>& target, const Rect& area) const;
 };
 
 #endif // GAMEMAP_HPP
@@ -0,0 +1,87 @@
+#include "Arena/Agent.hpp"
+#include "Cells/Grounds/PlayableGround.hpp"
+#include "GameElements/Town.hpp"
+#include "GameElements/Castle.hpp"
+#include "GameElements/Camp.hpp"
+#include "GameElements/Troops/Troop.hpp"
+#include "GameElements/Troops/Bandit.hpp"
+
+#include <stdexcept>
+
+std::unique_ptr<Agent> Agent::create(const std::string& name, unsigned int seed) {
+    if (name == "random") return std::make_unique<RandomAgent>(seed);
+    if (name == "greedy") return std::make_unique<GreedyAgent>(seed);
+
+    throw std::runtime_error("Agent inconnu: " + name);
+}
+
+
+RandomAgent::RandomAgent(unsigned int seed) : gen_(seed) {}
+
+Action RandomAgent::chooseAction(GameMap& map, const std::vector<Action>& moves) {
+    std::uniform_int_distribution<size_t> dist(0, moves.size() - 1);
+    return moves[dist(gen_)];
+}
+
+
+GreedyAgent::GreedyAgent(unsigned int seed) : gen_(seed) {}
+
+const int GreedyAgent::evaluate(GameMap& map, const Action& action) {
+    if (action.type == Action::Type::EndTurn) return 0;
+    if (action.type != Action::Type::Move && action.type != Action::Type::Buy) return -1;
+
+    auto to = PlayableGround::cast(map.get(action.to.getX(), action.to.getY()));
+    auto cp = map.getCurrentPlayer();
+    if (!to || !cp) return -1;
+
+    // Gain of the target cell
+    auto elt = to->getElement();
+    int gain = to->getOwner() != cp ? 10 : 0;
+    if (Town::is(elt))
+        gain += 100;
+    else if (Castle::is(elt))
+        gain += 30;
+    else if (Camp::is(elt))
+        gain += 20;
+    else if (Bandit::is(elt))
+        gain += 8;
+    else if (auto troop = Troop::cast(elt); troop && to->getOwner() != cp)
+        gain += 10 * troop->getStrength();
+
+    if (gain <= 0) return -1;
+    if (action.type == Action::Type::Move) return gain;
+
+    // Buy only if the region can pay the upkeep
+    auto from = PlayableGround::cast(map.get(action.from.getX(), action.from.getY()));
+    auto bought = GameMap::createGameElement(action.element, Point{0, 0});
+    if (!from || !bought) return -1;
+
+    int income = 0;
+    for (auto& town : from->getTowns())
+        if (auto ltown = town.lock())
+            income += ltown->getIncome();
+    if (income - bought->getUpkeep() < 0) return -1;
+
+    return gain - bought->getCost() / 10;
+}
+
+Action GreedyAgent::chooseAction(GameMap& map, const std::vector<Action>& moves) {
+    // Search best actions
+    int bestScore = -1;
+    std::vector<size_t> bests;
+    for (size_t i = 0; i < moves.size(); i++) {
+        int score = evaluate(map, moves[i]);
+        if (score > bestScore) {
+            bestScore = score;
+            bests.clear();
+        }
+        if (score == bestScore)
+            bests.push_back(i);
+    }
+
+    // End turn if nothing is worth playing
+    if (bests.empty()) return Action{};
+
+    std::uniform_int_distribution<size_t> dist(0, bests.size() - 1);
+    return moves[bests[dist(gen_)]];
+}
@@ -0,0 +1,362 @@
+#include "Arena/Arena.hpp"
+#include "Arena/Agent.hpp"
+#include "Widgets/GameMap.hpp"
+#include "GameElements/Player.hpp"
+#include "Rules/Replay.hpp"
+#include "Rules/ReplayPlayer.hpp"
+#include "MapGen/BinaryMap.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(const Clock::time_point& start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    /// Quote a field for CSV and JSON (the map names contain spaces)
+    std::string quote(const std::string& str) {
+        std::string quoted = "\"";
+        for (char c : str) {
+            if (c == '"' || c == '\\') quoted += '\\';
+            quoted += c;
+        }
+        return quoted + '"';
+    }
+
+    std::string hex(std::uint64_t value) {
+        std::ostringstream oss;
+        oss << std::hex << std::setw(16) << std::setfill('0') << value;
+        return oss.str();
+    }
+
+    std::string join(const std::vector<std::string>& strs, const std::string& sep) {
+        std::string joined;
+        for (size_t i = 0; i < strs.size(); i++)
+            joined += (i ? sep : "") + strs[i];
+        return joined;
+    }
+
+    double percentile(std::vector<double> values, double p) {
+        if (values.empty()) return 0;
+        std::sort(values.begin(), values.end());
+        return values[static_cast<size_t>(p * (values.size() - 1))];
+    }
+}
+
+std::vector<std::string> Arena::findMaps(const std::string& dir) {
+    if (!fs::exists(dir) || !fs::is_directory(dir))
+        throw std::runtime_error("Dossier de maps introuvable : " + dir);
+
+    std::vector<std::string> maps;
+    for (auto& entry : fs::directory_iterator(dir))
+        if (entry.is_regular_file() && (entry.path().extension() == ".ascii" || BinaryMap::isBinary(entry.path().string())))
+            maps.push_back(entry.path().string());
+
+    std::sort(maps.begin(), maps.end());
+    return maps;
+}
+
+Arena::Arena(const ArenaConfig& config) : config_(config) {
+    if (config_.maps.empty() && config_.replays.empty())
+        throw std::runtime_error("Aucune map à jouer.");
+    if (config_.agents.empty())
+        throw std::runtime_error("Aucun agent configuré.");
+
+    // Check names of agents
+    for (auto& name : config_.agents)
+        Agent::create(name, 0);
+}
+
+const std::vector<ArenaResult>& Arena::getResults() const {
+    return results_;
+}
+
+ArenaResult Arena::playGame(const std::string& map, int game, unsigned int seed) const {
+    ArenaResult result;
+    result.map = map;
+    result.game = game;
+    result.seed = seed;
+    auto gameStart = Clock::now();
+
+    try {
+        GameMap gameMap(Point{0, 0}, Size{800, 600}, map, seed);
+        gameMap.setRegionThreads(config_.regionThreads);
+
+        // Give an agent to each player, in turn
+        std::map<int, std::unique_ptr<Agent>> agents;
+        const auto& players = gameMap.getPlayers();
+        for (size_t seat = 0; seat < players.size(); seat++) {
+            auto player = players[seat].lock();
+            if (!player) continue;
+
+            const auto& name = config_.agents[(seat + game) % config_.agents.size()];
+            agents[player->getNum()] = Agent::create(name, seed * 31 + player->getNum());
+            result.agents.push_back(name);
+        }
+
+        // Play
+        std::vector<Action> moves;
+        int actionsInTurn = 0;
+        auto turnStart = Clock::now();
+        while (!gameMap.gameFinished() && result.turns < config_.maxTurns) {
+            auto cp = gameMap.getCurrentPlayer();
+            if (!cp) break;
+
+            // Choose action
+            gameMap.generateMoves(cp, moves);
+            Action action;
+            auto agent = agents.find(cp->getNum());
+            if (!moves.empty() && actionsInTurn < config_.maxActionsPerTurn && agent != agents.end())
+                action = agent->second->chooseAction(gameMap, moves);
+
+            gameMap.applyAction(action);
+            result.actions++;
+            actionsInTurn++;
+
+            // Next turn
+            if (action.type == Action::Type::EndTurn) {
+                result.turnMs.push_back(elapsedMs(turnStart));
+                result.turns++;
+                actionsInTurn = 0;
+                turnStart = Clock::now();
+            }
+        }
+
+        // Search winner
+        result.hash = gameMap.getHash();
+        auto winner = searchWinner(gameMap);
+        if (gameMap.gameFinished() && winner) {
+            result.winner = winner->getNum();
+            result.winnerAgent = agents[result.winner]->getName();
+        }
+
+        // Save replay
+        if (!config_.replaysDir.empty())
+            gameMap.getReplay().save((fs::path(config_.replaysDir) / (fs::path(map).stem().string() + "-" + std::to_string(seed) + ".krpl")).string());
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+
+    result.durationMs = elapsedMs(gameStart);
+    return result;
+}
+
+ArenaResult Arena::playReplay(const std::string& path, int game) const {
+    ArenaResult result;
+    result.map = path;
+    result.game = game;
+    auto gameStart = Clock::now();
+
+    try {
+        ReplayPlayer replayPlayer{Replay::load(path)};
+        result.map = replayPlayer.getReplay().getMapFile();
+        result.seed = replayPlayer.getReplay().getSeed();
+        auto gameMap = replayPlayer.createMap(Point{0, 0}, Size{800, 600});
+        gameMap->setRegionThreads(config_.regionThreads);
+
+        // Play back
+        auto turnStart = Clock::now();
+        const auto& actions = replayPlayer.getReplay().getActions();
+        while (!replayPlayer.isFinished()) {
+            bool endTurn = actions[replayPlayer.getPosition()].type == Action::Type::EndTurn;
+            replayPlayer.step(*gameMap);
+            result.actions++;
+
+            // Next turn
+            if (endTurn) {
+                result.turnMs.push_back(elapsedMs(turnStart));
+                result.turns++;
+                turnStart = Clock::now();
+            }
+        }
+
+        result.hash = gameMap->getHash();
+        auto winner = searchWinner(*gameMap);
+        if (gameMap->gameFinished() && winner)
+            result.winner = winner->getNum();
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+
+    result.durationMs = elapsedMs(gameStart);
+    return result;
+}
+
+std::shared_ptr<Player> Arena::searchWinner(const GameMap& gameMap) {
+    std::shared_ptr<Player> winner;
+    int nbPlayersInGame = 0;
+    for (auto& player : gameMap.getPlayers()) {
+        auto lplayer = player.lock();
+        if (lplayer && lplayer->hasTowns()) {
+            winner = lplayer;
+            nbPlayersInGame++;
+        }
+    }
+
+    return nbPlayersInGame == 1 ? winner : nullptr;
+}
+
+void Arena::run() {
+    bool replays = !config_.replays.empty();
+    results_.assign(replays ? config_.replays.size() : config_.maps.size() * config_.gamesPerMap, ArenaResult{});
+    int nbThreads = config_.threads > 0 ? config_.threads : std::max(1u, std::thread::hardware_concurrency());
+    if (!replays && !config_.replaysDir.empty())
+        fs::create_directories(config_.replaysDir);
+
+    // One game per worker
+    std::atomic<size_t> nextGame{0};
+    auto worker = [this, replays, &nextGame]() {
+        for (size_t i = nextGame++; i < results_.size(); i = nextGame++) {
+            if (replays)
+                results_[i] = playReplay(config_.replays[i], static_cast<int>(i));
+            else
+                results_[i] = playGame(config_.maps[i / config_.gamesPerMap], i % config_.gamesPerMap, config_.seed + static_cast<unsigned int>(i));
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < nbThreads; i++)
+        workers.emplace_back(worker);
+    for (auto& w : workers)
+        w.join();
+}
+
+void Arena::writeCsv(const std::string& path) const {
+    std::ofstream out{path};
+    if (!out)
+        throw std::runtime_error("Impossible d'ouvrir le fichier en écriture: " + path);
+
+    out << "map,game,seed,agents,winner,winner_agent,turns,actions,duration_ms,mean_turn_ms,max_turn_ms,hash,error\n";
+    for (auto& result : results_) {
+        double meanTurn = result.turnMs.empty() ? 0 : std::accumulate(result.turnMs.begin(), result.turnMs.end(), 0.0) / result.turnMs.size();
+        double maxTurn = result.turnMs.empty() ? 0 : *std::max_element(result.turnMs.begin(), result.turnMs.end());
+
+        out << quote(fs::path(result.map).stem().string()) << ','
+            << result.game << ','
+            << result.seed << ','
+            << join(result.agents, ";") << ','
+            << result.winner << ','
+            << result.winnerAgent << ','
+            << result.turns << ','
+            << result.actions << ','
+            << result.durationMs << ','
+            << meanTurn << ','
+            << maxTurn << ','
+            << hex(result.hash) << ','
+            << quote(result.error) << '\n';
+    }
+}
+
+void Arena::writeJson(const std::string& path) const {
+    std::ofstream out{path};
+    if (!out)
+        throw std::runtime_error("Impossible d'ouvrir le fichier en écriture: " + path);
+
+    // Win rates of agents
+    std::map<std::string, std::pair<int, int>> agentStats;    // games, wins
+    std::map<std::string, std::vector<const ArenaResult*>> mapResults;
+    std::vector<double> turnMs;
+    int nbErrors = 0;
+    int nbDraws = 0;
+
+    for (auto& result : results_) {
+        mapResults[fs::path(result.map).stem().string()].push_back(&result);
+        if (!result.error.empty()) {
+            nbErrors++;
+            continue;
+        }
+        if (!result.winner) nbDraws++;
+
+        std::vector<std::string> names = result.agents;
+        std::sort(names.begin(), names.end());
+        names.erase(std::unique(names.begin(), names.end()), names.end());
+        for (auto& name : names)
+            agentStats[name].first++;
+        if (result.winner && !result.winnerAgent.empty())
+            agentStats[result.winnerAgent].second++;
+
+        turnMs.insert(turnMs.end(), result.turnMs.begin(), result.turnMs.end());
+    }
+
+    out << "{\n";
+    out << "  \"games\": " << results_.size() << ",\n";
+    out << "  \"errors\": " << nbErrors << ",\n";
+    out << "  \"draws\": " << nbDraws << ",\n";
+
+    // Agents
+    out << "  \"agents\": {";
+    bool first = true;
+    for (auto& [name, stats] : agentStats) {
+        out << (first ? "\n" : ",\n") << "    " << quote(name) << ": {\"games\": " << stats.first
+            << ", \"wins\": " << stats.second
+            << ", \"win_rate\": " << (stats.first ? static_cast<double>(stats.second) / stats.first : 0) << "}";
+        first = false;
+    }
+    out << "\n  },\n";
+
+    // Maps
+    out << "  \"maps\": {";
+    first = true;
+    for (auto& [name, results] : mapResults) {
+        std::map<std::string, int> wins;
+        int nbGames = 0;
+        int nbTurns = 0;
+        for (auto result : results) {
+            if (!result->error.empty()) continue;
+            nbGames++;
+            nbTurns += result->turns;
+            if (result->winner && !result->winnerAgent.empty()) wins[result->winnerAgent]++;
+        }
+
+        out << (first ? "\n" : ",\n") << "    " << quote(name) << ": {\"games\": " << nbGames
+            << ", \"mean_turns\": " << (nbGames ? static_cast<double>(nbTurns) / nbGames : 0) << ", \"wins\": {";
+        bool firstWin = true;
+        for (auto& [agent, nbWins] : wins) {
+            out << (firstWin ? "" : ", ") << quote(agent) << ": " << nbWins;
+            firstWin = false;
+        }
+        out << "}}";
+        first = false;
+    }
+    out << "\n  },\n";
+
+    // Timings
+    out << "  \"turn_ms\": {\"mean\": " << (turnMs.empty() ? 0 : std::accumulate(turnMs.begin(), turnMs.end(), 0.0) / turnMs.size())
+        << ", \"p50\": " << percentile(turnMs, 0.5)
+        << ", \"p95\": " << percentile(turnMs, 0.95)
+        << ", \"max\": " << percentile(turnMs, 1) << "},\n";
+
+    // Games
+    out << "  \"results\": [";
+    for (size_t i = 0; i < results_.size(); i++) {
+        auto& result = results_[i];
+        out << (i ? ",\n" : "\n") << "    {\"map\": " << quote(fs::path(result.map).stem().string())
+            << ", \"game\": " << result.game
+            << ", \"seed\": " << result.seed
+            << ", \"agents\": [";
+        for (size_t j = 0; j < result.agents.size(); j++)
+            out << (j ? ", " : "") << quote(result.agents[j]);
+        out << "], \"winner\": " << result.winner
+            << ", \"turns\": " << result.turns
+            << ", \"actions\": " << result.actions
+            << ", \"duration_ms\": " << result.durationMs
+            << ", \"hash\": " << quote(hex(result.hash))
+            << ", \"error\": " << quote(result.error) << "}";
+    }
+    out << "\n  ]\n}\n";
+}
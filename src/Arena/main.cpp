@@ -0,0 +1,91 @@
+#include "Arena/Arena.hpp"
+#include "Displayers/Displayer.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    void printUsage() {
+        std::cout << "Usage: konkr-arena [options] [map.ascii...]\n"
+                  << "  --maps DIR        Play every map of DIR (default: ../assets/map)\n"
+                  << "  --games N         Games per map (default: 10)\n"
+                  << "  --threads N       Worker threads (default: one per core)\n"
+                  << "  --region-threads N Threads of each game for the incomes of its regions (default: 1)\n"
+                  << "  --agents A,B,...  Agents given to players in turn: greedy, random (default: greedy,random)\n"
+                  << "  --max-turns N     Player turns before a draw (default: 500)\n"
+                  << "  --max-actions N   Actions per turn before ending it (default: 100)\n"
+                  << "  --seed N          Seed of the first game (default: 0)\n"
+                  << "  --replays DIR     Save the replay of each game in DIR\n"
+                  << "  --replay FILE     Play back a replay at once instead of playing games (repeatable)\n"
+                  << "  --csv FILE        Per-game results (default: arena.csv)\n"
+                  << "  --json FILE       Summary (default: arena.json)\n";
+    }
+
+    std::vector<std::string> split(const std::string& str, char sep) {
+        std::vector<std::string> parts;
+        std::string part;
+        std::istringstream iss(str);
+        while (std::getline(iss, part, sep))
+            if (!part.empty()) parts.push_back(part);
+        return parts;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    ArenaConfig config;
+    std::string mapsDir = "../assets/map";
+    std::string csvPath = "arena.csv";
+    std::string jsonPath = "arena.json";
+
+    try {
+        // Read arguments
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error("Valeur manquante pour " + arg);
+                return argv[++i];
+            };
+
+            if (arg == "--help" || arg == "-h") { printUsage(); return 0; }
+            else if (arg == "--maps") mapsDir = next();
+            else if (arg == "--games") config.gamesPerMap = std::stoi(next());
+            else if (arg == "--threads") config.threads = std::stoi(next());
+            else if (arg == "--region-threads") config.regionThreads = std::stoi(next());
+            else if (arg == "--agents") config.agents = split(next(), ',');
+            else if (arg == "--max-turns") config.maxTurns = std::stoi(next());
+            else if (arg == "--max-actions") config.maxActionsPerTurn = std::stoi(next());
+            else if (arg == "--seed") config.seed = static_cast<unsigned int>(std::stoul(next()));
+            else if (arg == "--replays") config.replaysDir = next();
+            else if (arg == "--replay") config.replays.push_back(next());
+            else if (arg == "--csv") csvPath = next();
+            else if (arg == "--json") jsonPath = next();
+            else if (arg.rfind("--", 0) == 0) throw std::runtime_error("Option inconnue: " + arg);
+            else config.maps.push_back(arg);
+        }
+        if (config.maps.empty() && config.replays.empty())
+            config.maps = Arena::findMaps(mapsDir);
+
+        // Play without display
+        Displayer::initHeadless();
+
+        Arena arena{config};
+        arena.run();
+        arena.writeCsv(csvPath);
+        arena.writeJson(jsonPath);
+
+        // Summary
+        int nbErrors = 0;
+        for (auto& result : arena.getResults())
+            if (!result.error.empty()) nbErrors++;
+        std::cout << arena.getResults().size() << " parties jouées (" << nbErrors << " erreurs) -> "
+                  << csvPath << ", " << jsonPath << std::endl;
+        return nbErrors ? 1 : 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        printUsage();
+        return 1;
+    }
+}
@@ -0,0 +1,121 @@
+#include "Bench/Benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    /// Human readable duration
+    std::string formatNs(double ns) {
+        char buffer[32];
+        if (ns >= 1e6) std::snprintf(buffer, sizeof(buffer), "%.2f ms", ns / 1e6);
+        else if (ns >= 1e3) std::snprintf(buffer, sizeof(buffer), "%.2f us", ns / 1e3);
+        else std::snprintf(buffer, sizeof(buffer), "%.0f ns", ns);
+        return buffer;
+    }
+}
+
+Benchmark::Benchmark(double minTimeMs, long maxIterations, const std::string& filter)
+    : minTimeMs_(minTimeMs), maxIterations_(maxIterations), filter_(filter)
+{}
+
+const bool Benchmark::enabled(const std::string& name) const {
+    return filter_.empty() || name.find(filter_) != std::string::npos;
+}
+
+void Benchmark::run(const std::string& name, const std::string& map, int cells,
+                    const std::function<void()>& setup, const std::function<void()>& op) {
+    if (!enabled(name)) return;
+
+    // Warm up
+    if (setup) setup();
+    op();
+
+    // Timed iterations
+    std::vector<double> durations;
+    double totalNs = 0;
+    while (static_cast<long>(durations.size()) < maxIterations_ && (totalNs < minTimeMs_ * 1e6 || durations.size() < 3)) {
+        if (setup) setup();
+
+        auto start = Clock::now();
+        op();
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        durations.push_back(ns);
+        totalNs += ns;
+    }
+
+    // Stats
+    BenchmarkResult result;
+    result.name = name;
+    result.map = map;
+    result.cells = cells;
+    result.iterations = static_cast<long>(durations.size());
+    result.meanNs = totalNs / durations.size();
+    std::sort(durations.begin(), durations.end());
+    result.medianNs = durations[durations.size() / 2];
+    result.minNs = durations.front();
+    results_.push_back(result);
+
+    std::cout << name << " [" << map << "] " << formatNs(result.medianNs) << std::endl;
+}
+
+void Benchmark::addCounter(const std::string& name, double total) {
+    if (results_.empty()) return;
+
+    auto& result = results_.back();
+    result.counters[name] = total / (result.iterations + 1);
+}
+
+void Benchmark::skip(const std::string& name, const std::string& map, int cells, const std::string& reason) {
+    if (!enabled(name)) return;
+
+    BenchmarkResult result;
+    result.name = name;
+    result.map = map;
+    result.cells = cells;
+    result.skipped = reason;
+    results_.push_back(result);
+}
+
+const std::vector<BenchmarkResult>& Benchmark::getResults() const {
+    return results_;
+}
+
+void Benchmark::print() const {
+    std::printf("\n%-24s %-20s %8s %10s %12s %12s %12s\n", "benchmark", "map", "cells", "iterations", "median", "mean", "min");
+    for (auto& result : results_) {
+        if (!result.skipped.empty()) {
+            std::printf("%-24s %-20s %8d %10s %s\n", result.name.c_str(), result.map.c_str(), result.cells, "-", result.skipped.c_str());
+            continue;
+        }
+
+        std::printf("%-24s %-20s %8d %10ld %12s %12s %12s", result.name.c_str(), result.map.c_str(), result.cells, result.iterations,
+                    formatNs(result.medianNs).c_str(), formatNs(result.meanNs).c_str(), formatNs(result.minNs).c_str());
+        for (auto& [name, value] : result.counters)
+            std::printf("  %s=%.1f", name.c_str(), value);
+        std::printf("\n");
+    }
+}
+
+void Benchmark::writeCsv(const std::string& path) const {
+    std::ofstream out{path};
+    if (!out)
+        throw std::runtime_error("Impossible d'ouvrir le fichier en écriture: " + path);
+
+    out << "benchmark,map,cells,iterations,median_ns,mean_ns,min_ns,counters,skipped\n";
+    for (auto& result : results_) {
+        std::string counters;
+        for (auto& [name, value] : result.counters)
+            counters += (counters.empty() ? "" : ";") + name + "=" + std::to_string(value);
+
+        out << result.name << ",\"" << result.map << "\"," << result.cells << ',' << result.iterations << ','
+            << result.medianNs << ',' << result.meanNs << ',' << result.minNs << ",\"" << counters << "\",\"" << result.skipped << "\"\n";
+    }
+}
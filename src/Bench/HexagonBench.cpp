@@ -0,0 +1,97 @@
+#include "Bench/HexagonBench.hpp"
+#include "Utils/HexagonUtils.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+    /// Cells around the origin whose every pixel is checked, in each direction
+    constexpr int CHECKED_PIXEL_CELLS = 3;
+
+    /// Cells (or pixels) of a square grid, row after row
+    struct Grid {
+        std::vector<int> xs;
+        std::vector<int> ys;
+
+        Grid(int first, int last, int step = 1) {
+            for (int y = first; y < last; y += step)
+                for (int x = first; x < last; x += step) {
+                    xs.push_back(x);
+                    ys.push_back(y);
+                }
+        }
+    };
+
+    void throwMismatch(const std::string& function, int x, int y) {
+        throw std::runtime_error("Conversion vectorisée différente de la scalaire: " + function
+                                 + "(" + std::to_string(x) + ", " + std::to_string(y) + ")");
+    }
+
+    void checkRadius(double hexSize) {
+        if (!(hexSize > 0))
+            throw std::runtime_error("Rayon d'hexagone invalide: " + std::to_string(hexSize));
+    }
+}
+
+void HexagonBench::check(int size, double hexSize) {
+    checkRadius(hexSize);
+
+    // Cells, negative coordinates included
+    Grid cells{-size, size};
+    std::vector<int> xs(cells.xs.size()), ys(cells.xs.size());
+
+    HexagonUtils::offsetToPixel(cells.xs, cells.ys, hexSize, xs, ys);
+    for (size_t i = 0; i < xs.size(); i++)
+        if (std::pair{xs[i], ys[i]} != HexagonUtils::offsetToPixel(cells.xs[i], cells.ys[i], hexSize))
+            throwMismatch("offsetToPixel", cells.xs[i], cells.ys[i]);
+
+    HexagonUtils::axialToPixel(cells.xs, cells.ys, hexSize, xs, ys);
+    for (size_t i = 0; i < xs.size(); i++)
+        if (std::pair{xs[i], ys[i]} != HexagonUtils::axialToPixel(cells.xs[i], cells.ys[i], hexSize))
+            throwMismatch("axialToPixel", cells.xs[i], cells.ys[i]);
+
+    // Every pixel of the cells around the origin
+    const int pixelsAround = static_cast<int>(std::ceil(CHECKED_PIXEL_CELLS * 2 * hexSize));
+    Grid pixels{-pixelsAround, pixelsAround};
+    std::vector<int> qs(pixels.xs.size()), rs(pixels.xs.size());
+
+    HexagonUtils::pixelToAxial(pixels.xs, pixels.ys, hexSize, qs, rs);
+    for (size_t i = 0; i < qs.size(); i++)
+        if (std::pair{qs[i], rs[i]} != HexagonUtils::pixelToAxial(pixels.xs[i], pixels.ys[i], hexSize))
+            throwMismatch("pixelToAxial", pixels.xs[i], pixels.ys[i]);
+}
+
+void HexagonBench::run(Benchmark& bench, int size, double hexSize) {
+    checkRadius(hexSize);
+    const std::string map = "grid-" + std::to_string(size);
+    const std::string isa = HexagonUtils::BATCH_ISA;
+
+    Grid cells{0, size};
+    const int count = static_cast<int>(cells.xs.size());
+    std::vector<int> xs(count), ys(count);
+
+    // Cells to pixels (GameMap loading)
+    bench.run("offsetToPixel scalar", map, count, {}, [&]() {
+        for (int i = 0; i < count; i++)
+            std::tie(xs[i], ys[i]) = HexagonUtils::offsetToPixel(cells.xs[i], cells.ys[i], hexSize);
+    });
+    bench.run("offsetToPixel " + isa, map, count, {}, [&]() {
+        HexagonUtils::offsetToPixel(cells.xs, cells.ys, hexSize, xs, ys);
+    });
+
+    // Pixels to cells, one point per cell
+    HexagonUtils::offsetToPixel(cells.xs, cells.ys, hexSize, xs, ys);
+    std::vector<int> qs(count), rs(count);
+
+    bench.run("pixelToAxial scalar", map, count, {}, [&]() {
+        for (int i = 0; i < count; i++)
+            std::tie(qs[i], rs[i]) = HexagonUtils::pixelToAxial(xs[i], ys[i], hexSize);
+    });
+    bench.run("pixelToAxial " + isa, map, count, {}, [&]() {
+        HexagonUtils::pixelToAxial(xs, ys, hexSize, qs, rs);
+    });
+}
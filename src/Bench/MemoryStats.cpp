@@ -0,0 +1,40 @@
+#include "Bench/MemoryStats.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    /// Space kept before each block for its size (keeps the default alignment)
+    constexpr std::size_t HEADER = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    /// Bytes allocated and not deleted yet (the workers allocate too)
+    std::atomic<long> liveBytes{0};
+
+    void* allocate(std::size_t size) {
+        void* block = std::malloc(HEADER + size);
+        if (!block) throw std::bad_alloc();
+        *static_cast<std::size_t*>(block) = size;
+        liveBytes += static_cast<long>(size);
+        return static_cast<char*>(block) + HEADER;
+    }
+
+    void deallocate(void* ptr) noexcept {
+        if (!ptr) return;
+        void* block = static_cast<char*>(ptr) - HEADER;
+        liveBytes -= static_cast<long>(*static_cast<std::size_t*>(block));
+        std::free(block);
+    }
+}
+
+const long MemoryStats::getLiveBytes() {
+    return liveBytes;
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { deallocate(ptr); }
@@ -0,0 +1,62 @@
+#include "Bench/RenderBench.hpp"
+#include "Game.hpp"
+#include "Menus/GameMenu.hpp"
+#include "Widgets/GameMap.hpp"
+#include "SDLWrappers/Renderers/Window.hpp"
+#include "SDLWrappers/Renderers/RenderStats.hpp"
+
+#include <memory>
+#include <string>
+
+namespace {
+    /// Offscreen window shared by the benchmarks
+    std::shared_ptr<Window> window;
+
+    /// Keep the blits, written pixels and target switches per frame of the last run
+    void addRenderCounters(Benchmark& bench, const std::string& name) {
+        if (!bench.enabled(name)) return;
+        bench.addCounter("blits", static_cast<double>(RenderStats::getBlits()));
+        bench.addCounter("pixels", static_cast<double>(RenderStats::getPixels()));
+        bench.addCounter("switches", static_cast<double>(RenderStats::getTargetSwitches()));
+    }
+}
+
+void RenderBench::init(const Size& resolution) {
+    window = std::make_shared<Window>(resolution);
+    Game::initResources(window->getRenderer());
+}
+
+void RenderBench::quit() {
+    Game::quitResources();
+    window.reset();
+}
+
+void RenderBench::run(Benchmark& bench, const std::string& mapFile, const std::string& name) {
+    const Size mapSize = window->getSize() * 0.75;
+
+    // Map alone: redraw of its cache, then redraw and blit on the window
+    GameMap map(Point{0, 0}, mapSize, mapFile, 0);
+    int cells = map.getWidth() * map.getHeight();
+
+    RenderStats::reset();
+    bench.run("GameMap::refresh", name, cells, {}, [&]() { map.refresh(); });
+    addRenderCounters(bench, "GameMap::refresh");
+
+    RenderStats::reset();
+    bench.run("GameMap::display", name, cells, {}, [&]() { map.display(window); });
+    addRenderCounters(bench, "GameMap::display");
+
+    // Map zoomed 4 times around the center of the window, mostly off-screen
+    map.setProportionalSize(map.getSize() * 4);
+    map.setPos(Point{window->getSize() / 2} - Point{map.getSize() / 2});
+    RenderStats::reset();
+    bench.run("GameMap::display zoom", name, cells, {}, [&]() { map.display(window); });
+    addRenderCounters(bench, "GameMap::display zoom");
+
+    // Whole frame of the game: map, overlay and buttons
+    if (!bench.enabled("GameMenu::draw")) return;
+    GameMenu menu(window, mapFile);
+    RenderStats::reset();
+    bench.run("GameMenu::draw", name, cells, {}, [&]() { menu.draw(); });
+    addRenderCounters(bench, "GameMenu::draw");
+}
@@ -0,0 +1,228 @@
+#include "Bench/RulesBench.hpp"
+#include "Bench/MemoryStats.hpp"
+#include "Widgets/GameMap.hpp"
+#include "Cells/Grounds/PlayableGround.hpp"
+#include "GameElements/Town.hpp"
+#include "GameElements/Troops/Troop.hpp"
+#include "GameElements/Troops/Bandit.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    /// Size of the square region of a player in synthetic maps
+    constexpr int REGION_SIZE = 8;
+
+    /// Threads of the parallel updateAllIncomes benchmark
+    constexpr int REGION_THREADS = 4;
+
+    /// Capture used by the moveTroop benchmark
+    struct Capture {
+        Point from;
+        Point to;
+        int strength = 0;
+    };
+}
+
+std::string RulesBench::writeSyntheticMap(int size, const std::string& dir) {
+    fs::create_directories(dir);
+    std::string path = (fs::path(dir) / ("synthetic-" + std::to_string(size) + ".ascii")).string();
+    std::ofstream out{path};
+    if (!out)
+        throw std::runtime_error("Impossible d'ouvrir le fichier en écriture: " + path);
+
+    std::mt19937 gen(static_cast<unsigned int>(size));
+    std::uniform_int_distribution<> percent(0, 99);
+
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            int rx = x % REGION_SIZE;
+            int ry = y % REGION_SIZE;
+            int bx = x / REGION_SIZE;
+            int by = y / REGION_SIZE;
+            std::string token;
+
+            // Neutral lanes between groups of 4x4 regions, with bandits and a camp
+            if (y % (REGION_SIZE * 4) == REGION_SIZE * 4 - 1) {
+                if (x % (REGION_SIZE * 4) == REGION_SIZE * 2) token = "a.";
+                else token = percent(gen) < 10 ? "0B" : "0.";
+            }
+
+            // Town in the middle of each region
+            else if (rx == REGION_SIZE / 2 && ry == REGION_SIZE / 2) {
+                token = std::to_string(1 + (bx + by * 3) % 4) + "T";
+            }
+
+            // Ground of the player of the region, forests, lakes and troops
+            else {
+                int r = percent(gen);
+                char owner = static_cast<char>('1' + (bx + by * 3) % 4);
+                if (r < 4) token = "W.";
+                else if (r < 10) token = "F.";
+                else if (r < 18) token = std::string{owner, 'V'};
+                else if (r < 21) token = std::string{owner, 'P'};
+                else if (r < 23) token = std::string{owner, 'K'};
+                else token = std::string{owner, '.'};
+            }
+
+            out << token << (x + 1 < size ? " " : "");
+        }
+        out << '\n';
+    }
+
+    return path;
+}
+
+void RulesBench::run(Benchmark& bench, const std::string& mapFile, const std::string& name) {
+    const Point pos{0, 0};
+    const Size size{800, 600};
+
+    // Map loading, with the heap bytes of the loaded map (cells, elements, boards)
+    GameMap map(pos, size, mapFile, 0);
+    int w = map.getWidth();
+    int h = map.getHeight();
+    int cells = w * h;
+    double mapBytes = 0;
+    bench.run("loadMap", name, cells, {}, [&]() {
+        long before = MemoryStats::getLiveBytes();
+        GameMap loaded(pos, size, mapFile, 0);
+        mapBytes += static_cast<double>(MemoryStats::getLiveBytes() - before);
+    });
+    if (bench.enabled("loadMap")) {
+        bench.addCounter("bytes", mapBytes);
+        bench.addCounter("bytes/cell", mapBytes / cells);
+    }
+
+    auto cp = map.getCurrentPlayer();
+    if (!cp) {
+        bench.skip("updateIncomes", name, cells, "aucun joueur");
+        return;
+    }
+
+    // Incomes and links
+    bench.run("updateIncomes", name, cells, {}, [&]() { map.updateIncomes(cp); });
+    bench.run("updateIncomes all", name, cells, {}, [&]() {
+        for (auto& player : map.players_)
+            map.updateIncomes(player);
+    });
+    bench.run("updateAllIncomes", name, cells, {}, [&]() { map.updateAllIncomes(); });
+
+    // Same incomes with the regions shared between threads
+    auto incomes = [&]() {
+        std::vector<int> values;
+        for (auto& cell : map)
+            if (auto ground = PlayableGround::cast(cell))
+                if (auto town = Town::cast(ground->getElement()))
+                    values.push_back(town->getIncome());
+        return values;
+    };
+    auto serialIncomes = incomes();
+    map.setRegionThreads(REGION_THREADS);
+    bench.run("updateAllIncomes x" + std::to_string(REGION_THREADS), name, cells, {}, [&]() { map.updateAllIncomes(); });
+    map.setRegionThreads(1);
+    if (incomes() != serialIncomes)
+        throw std::runtime_error("Revenus parallèles différents des revenus séquentiels: " + name);
+    bench.run("updateLinks", name, cells, {}, [&]() { map.updateLinks(); });
+
+    // Bitboards: same shields as the grounds, then the steps of getReachable()
+    const auto& bitboards = map.getBitboards();
+    for (int s = 1; s < GameMap::REACHABLE_STRENGTHS; s++) {
+        auto shields = bitboards.getShields(s);
+        for (int i = 0; i < cells; i++)
+            if (auto pg = PlayableGround::cast(map.get(i % w, i / w)); pg && shields.test(i) != (pg->getShield() >= s))
+                throw std::runtime_error("Boucliers des bitboards différents de getShield(): " + name);
+    }
+
+    int regionCell = 0;
+    while (regionCell < cells && !bitboards.getPlayable().test(regionCell)) regionCell++;
+    if (regionCell < cells) {
+        auto region = bitboards.getRegion(regionCell);
+        bench.run("bitboard shields", name, cells, {}, [&]() { bitboards.getShields(2); });
+        bench.run("bitboard region", name, cells, {}, [&]() { bitboards.getRegion(regionCell); });
+        bench.run("bitboard reachable", name, cells, {}, [&]() { bitboards.getReachable(region, 2); });
+    }
+
+    // Save / undo
+    bench.run("save", name, cells, [&]() {
+        map.saves_.clear();
+        map.movedTroopsSave_.clear();
+        map.nbUndos_ = 0;
+    }, [&]() { map.save(); });
+    map.saves_.clear();
+    map.movedTroopsSave_.clear();
+    map.nbUndos_ = 0;
+
+    bench.run("undo", name, cells, [&]() { map.save(); }, [&]() { map.undo(); });
+
+    // Capture: troop of the current player next to a weaker cell (without town) of
+    // another player, or else of nobody (first turn of the shipped maps)
+    Capture capture;
+    int bestScore = 0;
+    for (int i = 0; i < cells; i++) {
+        auto pg = PlayableGround::cast(map.get(i % w, i / w));
+        if (!pg || pg->getOwner() != cp) continue;
+        auto troop = Troop::cast(pg->getElement());
+        if (!troop || Bandit::is(troop)) continue;
+
+        for (int dir = 0; dir < 6; dir++) {
+            int ni = map.getNeighborIndex(i, dir);
+            auto target = ni < 0 ? nullptr : PlayableGround::cast(map.get(ni % w, ni / w));
+            if (!target || target->getOwner() == cp || Town::is(target->getElement()) || target->getShield() >= troop->getStrength())
+                continue;
+
+            int score = (target->getOwner() ? 10 : 1) * troop->getStrength();
+            if (score > bestScore) {
+                bestScore = score;
+                capture = Capture{Point{i % w, i / w}, Point{ni % w, ni / w}, troop->getStrength()};
+            }
+        }
+    }
+
+    if (capture.strength) {
+        // Cells of the capture (fetched again after the undos: they are replaced)
+        auto from = PlayableGround::cast(map.get(capture.from.getX(), capture.from.getY()));
+        auto to = PlayableGround::cast(map.get(capture.to.getX(), capture.to.getY()));
+        bench.run("moveTroop capture", name, cells, [&]() {
+            while (map.nbUndos_ > 0) map.undo();
+            from = PlayableGround::cast(map.get(capture.from.getX(), capture.from.getY()));
+            to = PlayableGround::cast(map.get(capture.to.getX(), capture.to.getY()));
+            map.clearReachable();
+            map.showReachable(from, capture.strength);
+        }, [&]() { map.moveTroop(from, to); });
+
+        // Highlight of the same troop, flooded once then looked up
+        bench.run("showReachable", name, cells, [&]() { map.clearReachable(); }, [&]() { map.showReachable(from, capture.strength); });
+
+        // Same highlight after a change of the state (as in applyAction()): flooded each time
+        bench.run("showReachable uncached", name, cells, [&]() {
+            map.clearReachable();
+            map.reachableRegions_.clear();
+        }, [&]() { map.showReachable(from, capture.strength); });
+        map.clearReachable();
+
+        while (map.nbUndos_ > 0) map.undo();
+    } else {
+        bench.skip("moveTroop capture", name, cells, "aucune capture possible");
+    }
+
+    // Towns of a cell, on every owned cell in turn
+    std::vector<std::shared_ptr<PlayableGround>> owned;
+    for (auto& cell : map)
+        if (auto pg = PlayableGround::cast(cell))
+            if (pg->getOwner())
+                owned.push_back(pg);
+
+    size_t next = 0;
+    bench.run("getTowns", name, cells, [&]() { next = (next + 1) % owned.size(); }, [&]() { owned[next]->getTowns(); });
+    bench.run("getNearestTown", name, cells, [&]() { next = (next + 1) % owned.size(); }, [&]() { owned[next]->getNearestTown(); });
+
+    // Bandits (changes the map: last)
+    bench.run("moveBandits", name, cells, {}, [&]() { map.moveBandits(); });
+}
@@ -0,0 +1,135 @@
+#include "Bench/Benchmark.hpp"
+#include "Bench/RulesBench.hpp"
+#include "Bench/RenderBench.hpp"
+#include "Bench/HexagonBench.hpp"
+#include "Arena/Arena.hpp"
+#include "Displayers/Displayer.hpp"
+#include "Utils/HexagonUtils.hpp"
+
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    /// Inner radius of the island sprite (175 px wide), as loaded by Ground::init()
+    constexpr double ISLAND_INNER_RADIUS = 87;
+
+    /// Other radii of the conversion checks, not integer ones included
+    constexpr double CHECKED_RADII[] = {1, 7.25, 33.3, 64};
+
+    void printUsage() {
+        std::cout << "Usage: konkr_bench [options] [map.ascii...]\n"
+                  << "  --maps DIR        Benchmark every map of DIR (default: ../assets/map)\n"
+                  << "  --sizes A,B,...   Sizes of the synthetic maps (default: 64,128,256,512; 0 for none)\n"
+                  << "  --filter NAME     Only run benchmarks whose name contains NAME\n"
+                  << "  --min-time MS     Time spent in each benchmark (default: 200, not with --render)\n"
+                  << "  --max-iter N      Iterations limit of each benchmark (default: 100000)\n"
+                  << "  --render          Run the rendering benchmarks instead (synthetic size default: 64)\n"
+                  << "  --frames N        Frames drawn by each rendering benchmark (default: 100)\n"
+                  << "  --resolution WxH  Size of the offscreen window (default: 1280x720)\n"
+                  << "  --csv FILE        Write the results (default: bench.csv)\n";
+    }
+
+    std::vector<int> splitInts(const std::string& str, char sep = ',') {
+        std::vector<int> values;
+        std::string part;
+        std::istringstream iss(str);
+        while (std::getline(iss, part, sep))
+            if (!part.empty() && std::stoi(part) > 0) values.push_back(std::stoi(part));
+        return values;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> maps;
+    std::string mapsDir = "../assets/map";
+    std::vector<int> sizes = {64, 128, 256, 512};
+    bool sizesSet = false;
+    std::string filter;
+    double minTimeMs = 200;
+    bool minTimeSet = false;
+    long maxIterations = 100000;
+    std::string csvPath = "bench.csv";
+    bool render = false;
+    long frames = 100;
+    Size resolution{1280, 720};
+
+    try {
+        // Read arguments
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error("Valeur manquante pour " + arg);
+                return argv[++i];
+            };
+
+            if (arg == "--help" || arg == "-h") { printUsage(); return 0; }
+            else if (arg == "--maps") mapsDir = next();
+            else if (arg == "--sizes") { sizes = splitInts(next()); sizesSet = true; }
+            else if (arg == "--filter") filter = next();
+            else if (arg == "--min-time") { minTimeMs = std::stod(next()); minTimeSet = true; }
+            else if (arg == "--max-iter") maxIterations = std::stol(next());
+            else if (arg == "--render") render = true;
+            else if (arg == "--frames") frames = std::stol(next());
+            else if (arg == "--resolution") {
+                auto dims = splitInts(next(), 'x');
+                if (dims.size() != 2) throw std::runtime_error("Résolution invalide, attendu LxH: " + arg);
+                resolution = Size{dims[0], dims[1]};
+            }
+            else if (arg == "--csv") csvPath = next();
+            else if (arg.rfind("--", 0) == 0) throw std::runtime_error("Option inconnue: " + arg);
+            else maps.push_back(arg);
+        }
+        if (render && minTimeSet)
+            throw std::runtime_error("--min-time ne s'applique pas aux benchmarks de rendu (voir --frames)");
+        if (maps.empty())
+            maps = Arena::findMaps(mapsDir);
+
+        // Synthetic maps (rendering a whole big map takes long: keep them small)
+        if (render && !sizesSet) sizes = {64};
+        std::string syntheticDir = (std::filesystem::temp_directory_path() / "konkr_bench").string();
+        for (int size : sizes)
+            maps.push_back(RulesBench::writeSyntheticMap(size, syntheticDir));
+
+        Benchmark bench = render
+            ? Benchmark{std::numeric_limits<double>::max(), frames, filter}
+            : Benchmark{minTimeMs, maxIterations, filter};
+
+        if (render) {
+            // Frames drawn offscreen by the software renderer
+            RenderBench::init(resolution);
+            for (auto& map : maps)
+                RenderBench::run(bench, map, std::filesystem::path(map).stem().string());
+            RenderBench::quit();
+        }
+        else {
+            // Rules without display
+            Displayer::initHeadless();
+            for (auto& map : maps)
+                RulesBench::run(bench, map, std::filesystem::path(map).stem().string());
+
+            // Batch coordinate conversions, checked against the scalar ones first
+            // (sprites are not loaded headless: the radius of the islands is given)
+            const double hexSize = HexagonUtils::innerToRadius(ISLAND_INNER_RADIUS);
+            HexagonBench::check(16, hexSize);
+            for (double radius : CHECKED_RADII)
+                HexagonBench::check(16, radius);
+            for (int size : sizes)
+                HexagonBench::run(bench, size, hexSize);
+        }
+
+        bench.print();
+        bench.writeCsv(csvPath);
+        std::cout << "\n" << bench.getResults().size() << " mesures -> " << csvPath << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        printUsage();
+        return 1;
+    }
+}
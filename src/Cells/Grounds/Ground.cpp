@@ -57,14 +57,11 @@ Ground::Ground(const Point& pos): Displayer(pos, getIslandSize()) {}
 
 void Ground::display(const std::weak_ptr<BlitTarget>& target) const {
     if (auto ltarget = target.lock()) {
-        std::vector<bool> GroundNeighbors{
-            Ground::is(neighbors_[0]),
-            Ground::is(neighbors_[1]),
-            Ground::is(neighbors_[2]),
-            Ground::is(neighbors_[3])
-        };
-
-        islandDisplayer_.display(ltarget, pos_, GroundNeighbors);
+        std::uint8_t groundNeighbors = 0;
+        for (int i = 0; i < HexagonDisplayer::LINKED_NEIGHBORS; i++)
+            if (Ground::is(neighbors_[i])) groundNeighbors |= 1 << i;
+
+        islandDisplayer_.display(ltarget, pos_, groundNeighbors);
     }
 }
 
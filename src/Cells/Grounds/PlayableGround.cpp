@@ -3,6 +3,7 @@
 #include "Utils/ColorUtils.hpp"
 #include "GameElements/Castle.hpp"
 #include "GameElements/Camp.hpp"
+#include "GameElements/Town.hpp"
 #include "GameElements/Troops/Bandit.hpp"
 #include "GameElements/Troops/Troop.hpp"
 #include <algorithm>
@@ -31,6 +32,7 @@ std::shared_ptr<Cell> PlayableGround::deepCopy() const {
     pg->setOwner(oldOwner_);
     pg->setOwner(owner_);
     pg->element = element ? element->deepCopy() : nullptr;
+    pg->shield_ = shield_;
     return pg;
 }
 
@@ -86,13 +88,7 @@ void PlayableGround::quit() {
 
 PlayableGround::PlayableGround(const Point& pos, const std::shared_ptr<Player>& owner)
     : Ground(pos), owner_(owner)
-{
-    if (owner_) {
-        plate_ = owner_->getPlate();
-        lostPlate_ = owner_->getLostPlate();
-        hasPlate_ = true;
-    }
-}
+{}
 
 PlayableGround::PlayableGround(const Point& pos)
     : PlayableGround(pos, nullptr)
@@ -100,14 +96,23 @@ PlayableGround::PlayableGround(const Point& pos)
 
 void PlayableGround::setOwner(std::shared_ptr<Player> owner) {
     if (owner != owner_) {
+        if (auto hash = hash_.lock()) {
+            hash->toggle(ZobristHash::ownerKey(hashCell_, owner_ ? owner_->getNum() : 0));
+            hash->toggle(ZobristHash::ownerKey(hashCell_, owner ? owner->getNum() : 0));
+        }
+        if (auto bitboards = bitboards_.lock())
+            bitboards->setOwner(hashCell_, owner_ ? owner_->getNum() : 0, owner ? owner->getNum() : 0);
+
+        // The town changes hands
+        if (Town::is(element)) {
+            if (owner_) owner_->removeTownCell(this);
+            if (owner) owner->addTownCell(weak_from_this());
+        }
+
         oldOwner_ = owner == nullptr ? owner_ : nullptr;
         owner_ = owner;
-    }
-    
-    if (owner_) {
-        plate_ = owner_->getPlate();
-        lostPlate_ = owner_->getLostPlate();
-        hasPlate_ = true;
+        updateShields();
+        invalidateNearbyFences();
     }
 }
 
@@ -120,36 +125,39 @@ std::shared_ptr<Player> PlayableGround::getOldOwner() {
 }
 
 void PlayableGround::display(const std::weak_ptr<BlitTarget>& target) const {
-    if (!hasPlate_) return;
+    // Plates are looked up from the owner (or the lost owner), not stored by cells
+    if (!owner_ && !oldOwner_) return;
+
+    // Only the neighbors that the plate is linked to
+    std::uint8_t similarNeighbors = 0;
+    int nbLinked = std::min<int>(HexagonDisplayer::LINKED_NEIGHBORS, neighbors_.size());
 
-    std::vector<bool> similarNeighbors;
     if (owner_) {
-        for (auto& cell : neighbors_) {
-            if (auto pg = PlayableGround::cast(cell))
-                similarNeighbors.push_back(pg->getOwner() == owner_);
-            else
-                similarNeighbors.push_back(false);
+        for (int i = 0; i < nbLinked; i++) {
+            auto pg = PlayableGround::cast(neighbors_[i]);
+            if (pg && pg->getOwner() == owner_) similarNeighbors |= 1 << i;
         }
 
-        plate_.display(target, pos_, similarNeighbors);
+        owner_->getPlate().display(target, pos_, similarNeighbors);
 
     } else {
-        for (auto& cell : neighbors_) {
-            if (auto pg = PlayableGround::cast(cell))
-                similarNeighbors.push_back(pg->getOldOwner() == oldOwner_);
-            else
-                similarNeighbors.push_back(false);
+        for (int i = 0; i < nbLinked; i++) {
+            auto pg = PlayableGround::cast(neighbors_[i]);
+            if (pg && pg->getOldOwner() == oldOwner_) similarNeighbors |= 1 << i;
         }
         
-        lostPlate_.display(target, pos_, similarNeighbors);
+        oldOwner_->getLostPlate().display(target, pos_, similarNeighbors);
     }
 }
 
 const bool PlayableGround::hasFences() const {
+    if (!hasFencesOutdated_) return hasFences_;
+    hasFencesOutdated_ = false;
+
     if (element && (Castle::cast(element) || Town::cast(element) || Camp::cast(element)))
-        return true;
+        return hasFences_ = true;
 
-    return owner_ && std::any_of(neighbors_.begin(), neighbors_.end(), [this](const auto& cell) {
+    return hasFences_ = owner_ && std::any_of(neighbors_.begin(), neighbors_.end(), [this](const auto& cell) {
         if (auto pg = PlayableGround::cast(cell)) {
             if (pg->getOwner() != owner_) return false;
             auto elt = pg->getElement();
@@ -159,6 +167,40 @@ const bool PlayableGround::hasFences() const {
     });
 }
 
+const std::uint8_t PlayableGround::getFenceMask() const {
+    if (!fenceMaskOutdated_) return fenceMask_;
+    fenceMaskOutdated_ = false;
+
+    fenceMask_ = 0;
+    if (!owner_) return fenceMask_;
+
+    for (size_t i = 0; i < neighbors_.size(); i++) {
+        auto pg = PlayableGround::cast(neighbors_[i]);
+        if (pg && pg->getOwner() == owner_ && pg->hasFences())
+            fenceMask_ |= 1 << i;
+    }
+    return fenceMask_;
+}
+
+void PlayableGround::invalidateFences() {
+    hasFencesOutdated_ = true;
+    fenceMaskOutdated_ = true;
+}
+
+void PlayableGround::invalidateNearbyFences() {
+    // hasFences() reads the neighbors, and getFenceMask() reads hasFences() of the neighbors
+    invalidateFences();
+    for (auto& cell : neighbors_) {
+        auto pg = PlayableGround::cast(cell);
+        if (!pg) continue;
+
+        pg->invalidateFences();
+        for (auto& farCell : pg->neighbors_)
+            if (auto farPg = PlayableGround::cast(farCell))
+                farPg->fenceMaskOutdated_ = true;
+    }
+}
+
 const bool PlayableGround::isLinked(std::unordered_set<std::shared_ptr<PlayableGround>>& visited) {
     if (!owner_ || visited.find(shared_from_this()) != visited.end()) return false;
     visited.insert(shared_from_this());
@@ -330,8 +372,12 @@ std::shared_ptr<Town> PlayableGround::getNearestTown() {
     return getNearestTown(toVisit, visited);
 }
 
+const int PlayableGround::getIncome() const {
+    return element ? 1 - element->getUpkeep() : 1;
+}
+
 void PlayableGround::updateIncome() {
-    int income = element ? 1 - element->getUpkeep() : 1;
+    int income = getIncome();
     if (income == 0) return;
 
     if (auto town = getNearestTown())
@@ -341,17 +387,7 @@ void PlayableGround::updateIncome() {
 void PlayableGround::displayFences(const std::weak_ptr<Texture>& target) {
     if (!hasFences()) return;
 
-    std::vector<bool> similarNeighborsWithFences;
-    if (owner_) {
-        for (auto& cell : neighbors_) {
-            if (auto pg = PlayableGround::cast(cell))
-                similarNeighborsWithFences.push_back(pg->getOwner() == owner_ && pg->hasFences());
-            else
-                similarNeighborsWithFences.push_back(false);
-        }
-    } else similarNeighborsWithFences.resize(6, false);
-
-    fenceDisplayer_.display(target, pos_, similarNeighborsWithFences);
+    fenceDisplayer_.display(target, pos_, getFenceMask());
 }
 
 void PlayableGround::displayElement(const std::weak_ptr<Texture>& target) {
@@ -385,7 +421,7 @@ void PlayableGround::displayCross(const std::weak_ptr<Texture>& target) {
 
 void PlayableGround::displaySelectable(const std::weak_ptr<Texture>& target, const bool& selected) {
     auto ltarget = target.lock();
-    if (!ltarget || !selectable_ || (owner_ && owner_->hasSelected())) return;
+    if (!ltarget || (owner_ && owner_->hasSelected())) return;
 
     if (selected) {
         ltarget->blit(selectableSprite_, Point{
@@ -403,8 +439,23 @@ void PlayableGround::displaySelectable(const std::weak_ptr<Texture>& target, con
 
 
 void PlayableGround::setElement(const std::shared_ptr<GameElement>& elt) {
+    if (auto hash = hash_.lock()) {
+        hash->toggle(ZobristHash::elementKey(hashCell_, element));
+        hash->toggle(ZobristHash::elementKey(hashCell_, elt));
+    }
+    if (auto bitboards = bitboards_.lock())
+        bitboards->setElement(hashCell_, element, elt);
+
+    // Town built or destroyed
+    bool wasTown = Town::is(element);
+    bool isTown = Town::is(elt);
+    if (owner_ && wasTown && !isTown) owner_->removeTownCell(this);
+    else if (owner_ && !wasTown && isTown) owner_->addTownCell(weak_from_this());
+
     element = elt;
     if (element) elt->setPos(pos_);
+    updateShields();
+    invalidateNearbyFences();
 }
 
 std::shared_ptr<GameElement> PlayableGround::getElement() {
@@ -412,6 +463,10 @@ std::shared_ptr<GameElement> PlayableGround::getElement() {
 }
 
 const int PlayableGround::getShield() const {
+    return shield_;
+}
+
+void PlayableGround::updateShield() {
     int maxStrength = element ? element->getStrength() : 0;
 
     for (auto& cell : neighbors_) {
@@ -427,28 +482,32 @@ const int PlayableGround::getShield() const {
         maxStrength = std::max(maxStrength, elt->getStrength());
     }
 
-    return maxStrength;
+    shield_ = maxStrength;
 }
 
-void PlayableGround::setSelectable(bool selectable) {
-    selectable_ = selectable;
+void PlayableGround::updateShields() {
+    updateShield();
+    for (auto& cell : neighbors_)
+        if (auto pg = PlayableGround::cast(cell))
+            pg->updateShield();
 }
 
-void PlayableGround::updateSelectable(int strength, std::unordered_set<std::shared_ptr<PlayableGround>>& visited) {
-    if (visited.find(shared_from_this()) != visited.end()) return;
-    visited.insert(shared_from_this());
+void PlayableGround::attachHash(const std::weak_ptr<ZobristHash>& hash, int cell) {
+    hash_ = hash;
+    hashCell_ = cell;
 
-    selectable_ = strength >= 0;
-    
-    for (auto& cell : neighbors_) {
-        if (auto pg = PlayableGround::cast(cell)) {
-            if (pg->getOwner() == owner_) pg->updateSelectable(strength, visited);
-            else pg->setSelectable(strength > 0 && pg->getShield() < strength);
-        }
+    if (auto lhash = hash_.lock()) {
+        lhash->toggle(ZobristHash::ownerKey(hashCell_, owner_ ? owner_->getNum() : 0));
+        lhash->toggle(ZobristHash::elementKey(hashCell_, element));
     }
 }
 
-void PlayableGround::updateSelectable(int strength) {
-    std::unordered_set<std::shared_ptr<PlayableGround>> visited;
-    updateSelectable(strength, visited);
+void PlayableGround::attachBitboards(const std::weak_ptr<MapBitboards>& bitboards) {
+    bitboards_ = bitboards;
+
+    if (auto lbitboards = bitboards_.lock()) {
+        lbitboards->addPlayable(hashCell_);
+        lbitboards->setOwner(hashCell_, 0, owner_ ? owner_->getNum() : 0);
+        lbitboards->setElement(hashCell_, nullptr, element);
+    }
 }
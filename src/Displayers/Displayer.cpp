@@ -4,9 +4,20 @@
 #include "SDLWrappers/Renderers/Texture.hpp"
 
 std::weak_ptr<SDL_Renderer> Displayer::renderer_ = {};
+bool Displayer::headless_ = false;
 
 void Displayer::init(const std::shared_ptr<SDL_Renderer>& renderer) {
     renderer_ = renderer;
+    headless_ = false;
+}
+
+void Displayer::initHeadless() {
+    renderer_.reset();
+    headless_ = true;
+}
+
+const bool Displayer::isHeadless() {
+    return headless_;
 }
 
 
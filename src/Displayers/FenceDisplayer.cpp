@@ -1,5 +1,10 @@
 #include "Displayers/FenceDisplayer.hpp"
 #include "Utils/HexagonUtils.hpp"
+#include "Utils/ColorUtils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 
 FenceDisplayer::FenceDisplayer(double hexagonRadius, 
@@ -11,94 +16,95 @@ FenceDisplayer::FenceDisplayer(double hexagonRadius,
       bottom_(fenceBottom), bottomLeft_(fenceBottomLeft), bottomRight_(fenceBottomRight), 
       linkTop_(fenceLinkTop), linkTopLeft_(fenceLinkTopLeft), linkTopRight_(fenceLinkTopRight), 
       linkBottom_(fenceLinkBottom), linkBottomLeft_(fenceLinkBottomLeft), linkBottomRight_(fenceLinkBottomRight)
-{}
+{
+    // Without textures (headless), nothing to draw
+    if (top_) createVariants();
+}
 
 FenceDisplayer::~FenceDisplayer()
 {}
 
 
-void FenceDisplayer::display(const std::weak_ptr<BlitTarget>& target, const Point& pos, const std::vector<bool>& neighbors) const {
-    auto [x, y] = pos.get();
-    auto ltarget = target.lock();
-    if (!ltarget) return;
+void FenceDisplayer::forEachSegment(std::uint8_t neighbors, const std::function<void(const std::shared_ptr<Texture>&, double, double)>& visit) const {
+    auto has = [neighbors](int side) { return (neighbors >> side) & 1; };
 
-    if (!neighbors[5] && !neighbors[0]) {
-        ltarget->blit(top_, Point{
-            static_cast<int>(x - top_->getWidth() / 2.0),
-            static_cast<int>(y - top_->getHeight() / 2.0)
-        });
-    } else if (!neighbors[5] && neighbors[0]) {
-        ltarget->blit(linkTopRight_, Point{
-            static_cast<int>(x - 0.5 * innerRadius_ - linkTop_->getWidth() / 2.0),
-            static_cast<int>(y - 0.75 * radius_ - linkTop_->getHeight() / 2.0)
-        });
-    } else if (neighbors[5] && !neighbors[0]) {
-        ltarget->blit(linkTopLeft_, Point{
-            static_cast<int>(x + 0.5 * innerRadius_ - linkTop_->getWidth() / 2.0),
-            static_cast<int>(y - 0.75 * radius_ - linkTop_->getHeight() / 2.0)
-        });
-    }
+    if (!has(5) && !has(0))
+        visit(top_, -top_->getWidth() / 2.0, -top_->getHeight() / 2.0);
+    else if (!has(5) && has(0))
+        visit(linkTopRight_, -0.5 * innerRadius_ - linkTop_->getWidth() / 2.0, -0.75 * radius_ - linkTop_->getHeight() / 2.0);
+    else if (has(5) && !has(0))
+        visit(linkTopLeft_, 0.5 * innerRadius_ - linkTop_->getWidth() / 2.0, -0.75 * radius_ - linkTop_->getHeight() / 2.0);
 
-    if (!neighbors[0] && !neighbors[1]) {
-        ltarget->blit(topLeft_, Point{
-            static_cast<int>(x - topLeft_->getWidth() / 2.0),
-            static_cast<int>(y - topLeft_->getHeight() / 2.0)
-        });
-    } else if (!neighbors[0] && neighbors[1]) {
-        ltarget->blit(linkTop_, Point{
-            static_cast<int>(x - innerRadius_ - linkTop_->getWidth() / 2.0),
-            static_cast<int>(y - linkTop_->getHeight() / 2.0)
-        });
-    }
+    if (!has(0) && !has(1))
+        visit(topLeft_, -topLeft_->getWidth() / 2.0, -topLeft_->getHeight() / 2.0);
+    else if (!has(0) && has(1))
+        visit(linkTop_, -innerRadius_ - linkTop_->getWidth() / 2.0, -linkTop_->getHeight() / 2.0);
 
-    if (!neighbors[4] && !neighbors[5]) {
-        ltarget->blit(topRight_, Point{
-            static_cast<int>(x - topRight_->getWidth() / 2.0),
-            static_cast<int>(y - topRight_->getHeight() / 2.0)
-        });
-    }
+    if (!has(4) && !has(5))
+        visit(topRight_, -topRight_->getWidth() / 2.0, -topRight_->getHeight() / 2.0);
 
-    if (!neighbors[1] && !neighbors[2]) {
-        ltarget->blit(bottomLeft_, Point{
-            static_cast<int>(x - bottomLeft_->getWidth() / 2.0),
-            static_cast<int>(y - bottomLeft_->getHeight() / 2.0)
-        });
-    }
+    if (!has(1) && !has(2))
+        visit(bottomLeft_, -bottomLeft_->getWidth() / 2.0, -bottomLeft_->getHeight() / 2.0);
 
-    if (!neighbors[3] && !neighbors[4]) {
-        ltarget->blit(bottomRight_, Point{
-            static_cast<int>(x - bottomRight_->getWidth() / 2.0),
-            static_cast<int>(y - bottomRight_->getHeight() / 2.0)
-        });
-    } else if (!neighbors[3] && neighbors[4]) {
-        ltarget->blit(linkBottom_, Point{
-            static_cast<int>(x + innerRadius_ - linkBottom_->getWidth() / 2.0),
-            static_cast<int>(y - linkBottom_->getHeight() / 2.0)
+    if (!has(3) && !has(4))
+        visit(bottomRight_, -bottomRight_->getWidth() / 2.0, -bottomRight_->getHeight() / 2.0);
+    else if (!has(3) && has(4))
+        visit(linkBottom_, innerRadius_ - linkBottom_->getWidth() / 2.0, -linkBottom_->getHeight() / 2.0);
+
+    if (!has(2) && !has(3))
+        visit(bottom_, -bottom_->getWidth() / 2.0, -bottom_->getHeight() / 2.0);
+    else if (has(2) && !has(3))
+        visit(linkBottomRight_, -0.5 * innerRadius_ - linkBottomRight_->getWidth() / 2.0, 0.75 * radius_ - linkBottomRight_->getHeight() / 2.0);
+    else if (!has(2) && has(3))
+        visit(linkBottomLeft_, 0.5 * innerRadius_ - linkBottomLeft_->getWidth() / 2.0, 0.75 * radius_ - linkBottomLeft_->getHeight() / 2.0);
+}
+
+void FenceDisplayer::createVariants() {
+    // Bounds of every segment around the cell center (in whole pixels, as the blits are)
+    int minX = std::numeric_limits<int>::max(), minY = std::numeric_limits<int>::max();
+    int maxX = std::numeric_limits<int>::min(), maxY = std::numeric_limits<int>::min();
+    for (int neighbors = 0; neighbors < NB_VARIANTS; neighbors++) {
+        forEachSegment(neighbors, [&](const std::shared_ptr<Texture>& segment, double dx, double dy) {
+            minX = std::min(minX, static_cast<int>(std::floor(dx)));
+            minY = std::min(minY, static_cast<int>(std::floor(dy)));
+            maxX = std::max(maxX, static_cast<int>(std::floor(dx)) + segment->getWidth());
+            maxY = std::max(maxY, static_cast<int>(std::floor(dy)) + segment->getHeight());
         });
     }
+    variantCenter_ = Point{-minX, -minY};
 
-    if (!neighbors[2] && !neighbors[3]) {
-        ltarget->blit(bottom_, Point{
-            static_cast<int>(x - bottom_->getWidth() / 2.0),
-            static_cast<int>(y - bottom_->getHeight() / 2.0)
-        });
-    } else if (neighbors[2] && !neighbors[3]) {
-        ltarget->blit(linkBottomRight_, Point{
-            static_cast<int>(x - 0.5 * innerRadius_ - linkBottomRight_->getWidth() / 2.0),
-            static_cast<int>(y + 0.75 * radius_ - linkBottomRight_->getHeight() / 2.0)
-        });
-    } else if (!neighbors[2] && neighbors[3]) {
-        ltarget->blit(linkBottomLeft_, Point{
-            static_cast<int>(x + 0.5 * innerRadius_ - linkBottomLeft_->getWidth() / 2.0),
-            static_cast<int>(y + 0.75 * radius_ - linkBottomLeft_->getHeight() / 2.0)
+    // Draw the segments of each combination
+    variants_.assign(NB_VARIANTS, nullptr);
+    for (int neighbors = 0; neighbors < NB_VARIANTS; neighbors++) {
+        std::shared_ptr<Texture> variant;
+        forEachSegment(neighbors, [&](const std::shared_ptr<Texture>& segment, double dx, double dy) {
+            if (!variant) {
+                variant = std::make_shared<Texture>(renderer_, maxX - minX, maxY - minY);
+                variant->fill(ColorUtils::TRANSPARENT);
+            }
+
+            variant->blit(segment, Point{
+                static_cast<int>(variantCenter_.getX() + dx),
+                static_cast<int>(variantCenter_.getY() + dy)
+            });
         });
+        variants_[neighbors] = variant;
     }
 }
 
+void FenceDisplayer::display(const std::weak_ptr<BlitTarget>& target, const Point& pos, std::uint8_t neighbors) const {
+    auto ltarget = target.lock();
+    if (!ltarget || variants_.empty()) return;
+
+    auto& variant = variants_[neighbors & (NB_VARIANTS - 1)];
+    if (variant)
+        ltarget->blit(variant, pos - variantCenter_);
+}
+
 void FenceDisplayer::display(const std::weak_ptr<BlitTarget>& target, const Point& pos) const {
-    display(target, pos, {false, false, false, false, false, false});
+    display(target, pos, 0);
 }
 
 void FenceDisplayer::display(const std::weak_ptr<BlitTarget>& target) const {
-    display(target, pos_, {false, false, false, false, false, false});
+    display(target, pos_, 0);
 }
@@ -1,8 +1,11 @@
 
 #include "Utils/HexagonUtils.hpp"
+#include "Utils/ColorUtils.hpp"
 #include "Displayers/HexagonDisplayer.hpp"
 #include <SDL2/SDL2_gfxPrimitives.h>
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 HexagonDisplayer::HexagonDisplayer(double hexagonRadius, const std::shared_ptr<Texture> hexagonTexture, const std::shared_ptr<Texture> linkTexture, const std::shared_ptr<Texture> linkBottomLeftTexture, const std::shared_ptr<Texture> linkBottomTexture, const std::shared_ptr<Texture> linkBottomRightTexture)
     : GenericDisplayer(hexagonTexture ? hexagonTexture->getSize() : Size{0, 0}),
@@ -13,52 +16,78 @@ HexagonDisplayer::HexagonDisplayer(double hexagonRadius, const std::shared_ptr<T
       linkBottomLeft_(linkBottomLeftTexture),
       linkBottom_(linkBottomTexture),
       linkBottomRight_(linkBottomRightTexture)
-{}
+{
+    // Without textures (headless), nothing to draw
+    if (hexagon_) createAtlas();
+}
 
 HexagonDisplayer::~HexagonDisplayer()
 {}
 
 
-void HexagonDisplayer::display(const std::weak_ptr<BlitTarget>& target, const Point& pos, const std::vector<bool>& neighbors) const {
-    auto [x, y] = pos.get();
-    auto ltarget = target.lock();
-    if (!ltarget) return;
-    
-    // Draw hexagon
-    ltarget->blit(hexagon_, Point{
-        static_cast<int>(x - hexagon_->getWidth() / 2.0),
-        static_cast<int>(y - hexagon_->getHeight() / 2.0)
-    });
+void HexagonDisplayer::forEachPart(std::uint8_t neighbors, const std::function<void(const std::shared_ptr<Texture>&, double, double)>& visit) const {
+    // Hexagon
+    visit(hexagon_, -hexagon_->getWidth() / 2.0, -hexagon_->getHeight() / 2.0);
 
-    // Draw links
-    std::vector<std::shared_ptr<Texture>> links{linkBottomLeft_, linkBottom_, linkBottomRight_};
+    // Links
+    const std::shared_ptr<Texture>* links[3]{&linkBottomLeft_, &linkBottom_, &linkBottomRight_};
     for (int i = 0; i < 3; i++) {
-        if (!neighbors[i]) continue;
+        if (!((neighbors >> i) & 1)) continue;
 
-        std::shared_ptr<Texture> link = neighbors[i+1] ? link_ : links[i];
-        ltarget->blit(link, Point{
-            static_cast<int>(x - (innerRadius_ / (2 - (i%2))) - link->getWidth() / 2.0),
-            static_cast<int>(y + ((i-1) * radius_ * 0.75) - link->getHeight() / 2.0)
+        const std::shared_ptr<Texture>& link = ((neighbors >> (i+1)) & 1) ? link_ : *links[i];
+        visit(link,
+              -(innerRadius_ / (2 - (i%2))) - link->getWidth() / 2.0,
+              ((i-1) * radius_ * 0.75) - link->getHeight() / 2.0);
+    }
+}
+
+void HexagonDisplayer::createAtlas() {
+    // Bounds of every part around the center (in whole pixels, as the blits are)
+    int minX = std::numeric_limits<int>::max(), minY = std::numeric_limits<int>::max();
+    int maxX = std::numeric_limits<int>::min(), maxY = std::numeric_limits<int>::min();
+    for (int neighbors = 0; neighbors < NB_VARIANTS; neighbors++) {
+        forEachPart(neighbors, [&](const std::shared_ptr<Texture>& part, double dx, double dy) {
+            minX = std::min(minX, static_cast<int>(std::floor(dx)));
+            minY = std::min(minY, static_cast<int>(std::floor(dy)));
+            maxX = std::max(maxX, static_cast<int>(std::floor(dx)) + part->getWidth());
+            maxY = std::max(maxY, static_cast<int>(std::floor(dy)) + part->getHeight());
+        });
+    }
+    variantSize_ = Size{maxX - minX, maxY - minY};
+    variantCenter_ = Point{-minX, -minY};
+
+    // Variants side by side
+    atlas_ = std::make_shared<Texture>(renderer_, variantSize_.getWidth() * NB_VARIANTS, variantSize_.getHeight());
+    atlas_->fill(ColorUtils::TRANSPARENT);
+
+    for (int neighbors = 0; neighbors < NB_VARIANTS; neighbors++) {
+        Point center = variantCenter_ + Point{neighbors * variantSize_.getWidth(), 0};
+        forEachPart(neighbors, [&](const std::shared_ptr<Texture>& part, double dx, double dy) {
+            atlas_->blit(part, Point{
+                static_cast<int>(center.getX() + dx),
+                static_cast<int>(center.getY() + dy)
+            });
         });
     }
 }
 
-void HexagonDisplayer::display(const std::weak_ptr<BlitTarget>& target, const Point& pos) const {
-    display(target, pos, {false, false, false, false, false, false});
+void HexagonDisplayer::display(const std::weak_ptr<BlitTarget>& target, const Point& pos, std::uint8_t neighbors) const {
+    auto ltarget = target.lock();
+    if (!ltarget || !atlas_) return;
+
+    int variant = neighbors & (NB_VARIANTS - 1);
+    atlas_->colorize(tint_);
+    ltarget->blit(atlas_, Rect{Point{variant * variantSize_.getWidth(), 0}, variantSize_}, pos - variantCenter_);
 }
 
-void HexagonDisplayer::display(const std::weak_ptr<BlitTarget>& target) const {
-    display(target, pos_, {false, false, false, false, false, false});
+void HexagonDisplayer::display(const std::weak_ptr<BlitTarget>& target, const Point& pos) const {
+    display(target, pos, 0);
 }
 
-HexagonDisplayer HexagonDisplayer::copy() {
-    return HexagonDisplayer{radius_, hexagon_->copy(), link_->copy(), linkBottomLeft_->copy(), linkBottom_->copy(), linkBottomRight_->copy()};
+void HexagonDisplayer::display(const std::weak_ptr<BlitTarget>& target) const {
+    display(target, pos_, 0);
 }
 
 void HexagonDisplayer::colorize(const SDL_Color& color) {
-    hexagon_->colorize(color);
-    link_->colorize(color);
-    linkBottomLeft_->colorize(color);
-    linkBottom_->colorize(color);
-    linkBottomRight_->colorize(color);
-}
\ No newline at end of file
+    tint_ = color;
+}
@@ -0,0 +1,73 @@
+#include "Displayers/ProfilerDisplayer.hpp"
+#include "Profiling/FrameProfiler.hpp"
+#include "Utils/ColorUtils.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    /// Delay between two rebuilds of the text in ms
+    constexpr Uint32 UPDATE_DELAY = 500;
+
+    /// Margin around the text in pixels
+    constexpr int MARGIN = 6;
+}
+
+std::shared_ptr<Font> ProfilerDisplayer::font_ = nullptr;
+
+void ProfilerDisplayer::init() {
+    auto lrenderer = renderer_.lock();
+    if (!lrenderer)
+        throw std::runtime_error("Displayer not initialized");
+
+    font_ = std::make_shared<Font>(lrenderer, "../assets/fonts/Inter/static/Inter_18pt-SemiBold.ttf", 14);
+}
+
+void ProfilerDisplayer::quit() {
+    font_ = nullptr;
+}
+
+ProfilerDisplayer::ProfilerDisplayer(const Point& pos) : Displayer(pos) {}
+
+void ProfilerDisplayer::update() {
+    if (!font_) return;
+
+    Uint32 now = SDL_GetTicks();
+    if (!lines_.empty() && now - lastUpdate_ < UPDATE_DELAY) return;
+    lastUpdate_ = now;
+
+    // One line per stage
+    lines_.clear();
+    lines_.push_back(std::make_shared<Texture>(font_->render("stage   p50 / p95 / p99 (ms)", ColorUtils::WHITE)));
+    for (auto& stage : FrameProfiler::getStages()) {
+        char text[96];
+        std::snprintf(text, sizeof(text), "%s   %.2f / %.2f / %.2f", stage.c_str(),
+                      FrameProfiler::percentile(stage, 50), FrameProfiler::percentile(stage, 95), FrameProfiler::percentile(stage, 99));
+        lines_.push_back(std::make_shared<Texture>(font_->render(text, ColorUtils::WHITE)));
+    }
+
+    // Background fitting the text
+    Size size{0, MARGIN * 2};
+    for (auto& line : lines_)
+        size = Size{std::max(size.getWidth(), line->getWidth() + MARGIN * 2), size.getHeight() + line->getHeight()};
+
+    if (!bg_ || bg_->getWidth() != size.getWidth() || bg_->getHeight() != size.getHeight()) {
+        bg_ = std::make_shared<Texture>(renderer_, size);
+        bg_->fill(SDL_Color{0, 0, 0, 170});
+    }
+    size_ = size;
+}
+
+void ProfilerDisplayer::display(const std::weak_ptr<BlitTarget>& target) const {
+    auto ltarget = target.lock();
+    if (!ltarget || !bg_) return;
+
+    ltarget->blit(bg_, pos_);
+    Point linePos = pos_ + Point{MARGIN, MARGIN};
+    for (auto& line : lines_) {
+        ltarget->blit(line, linePos);
+        linePos.addY(line->getHeight());
+    }
+}
@@ -25,15 +25,18 @@ TreasuryDisplayer::TreasuryDisplayer(
     const Point& pos,
     int treasury, 
     int nextTreasury
-) : Displayer(pos, bg_->getSize()), treasury_(treasury), income_(nextTreasury)
+) : Displayer(pos, bg_ ? bg_->getSize() : Size{0, 0}), treasury_(treasury), income_(nextTreasury)
 {
-    if (!bg_)
+    if (!bg_ && !headless_)
         throw std::runtime_error("TreasuryDisplayer not initialized");
 
     refreshTexture();
 }
 
 void TreasuryDisplayer::refreshTexture() {
+    // Nothing to render without font (headless)
+    if (!font_) return;
+
     if (noIncome_)
         treasuryTex_ = std::make_shared<Texture>(font_->render(std::to_string(treasury_), ColorUtils::BLACK));
     else
@@ -56,7 +59,8 @@ void TreasuryDisplayer::setNoIncome(bool noIncome) {
 }
 
 void TreasuryDisplayer::display(const std::weak_ptr<BlitTarget>& target) const {
-    if (auto ltarget = target.lock()) {
+    auto ltarget = target.lock();
+    if (ltarget && bg_ && treasuryTex_) {
         ltarget->blit(bg_, Point{pos_.getX() - bg_->getWidth() / 2, pos_.getY() - bg_->getHeight() / 2});
         ltarget->blit(treasuryTex_, Point{pos_.getX() - treasuryTex_->getWidth() / 2, pos_.getY() - treasuryTex_->getHeight() / 2});
     }
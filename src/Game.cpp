@@ -21,13 +21,16 @@
 #include "SDLWrappers/Font.hpp"
 #include "Displayers/Displayer.hpp"
 #include "Displayers/TreasuryDisplayer.hpp"
+#include "Displayers/ProfilerDisplayer.hpp"
 #include "SDLWrappers/Cursor.hpp"
+#include "Menus/GameMenu.hpp"
+#include "Rules/Replay.hpp"
 
 #include <memory>
 #include <vector>
 
 
-Game::Game() {
+Game::Game(const std::string& replayFile, int replayDelay) {
     // Create Window
     window_ = std::make_shared<Window>("Konkr", windowSize_);
 
@@ -36,11 +39,27 @@ Game::Game() {
 
     // Init each class to initialize
     Cursor::init();
+    initResources(renderer);
+
+    // Select the current menu
+    if (!replayFile.empty())
+        menu_.reset(new GameMenu(window_, Replay::load(replayFile), replayDelay));
+    else
+        menu_.reset(new MainMenu(window_));
+}
+
+Game::~Game() {
+    quitResources();
+    Cursor::quit();
+}
+
+void Game::initResources(const std::shared_ptr<SDL_Renderer>& renderer) {
     Displayer::init(renderer);
     Ground::init();
     Forest::init();
     PlayableGround::init();
     TreasuryDisplayer::init();
+    ProfilerDisplayer::init();
 
     Troop::init();
     Town::init();
@@ -53,13 +72,9 @@ Game::Game() {
     Hero::init();
 
     Player::init(renderer);
-    GameMap::init();
-
-    // Select the current menu
-    menu_.reset(new MainMenu(window_));
 }
 
-Game::~Game() {
+void Game::quitResources() {
     Player::quit();
 
     Hero::quit();
@@ -73,10 +88,10 @@ Game::~Game() {
     Troop::quit();
     
     TreasuryDisplayer::quit();
+    ProfilerDisplayer::quit();
     PlayableGround::quit();
     Forest::quit();
     Ground::quit();
-    Cursor::quit();
 }
 
 void Game::run() {
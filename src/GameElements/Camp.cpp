@@ -29,7 +29,7 @@ void Camp::quit()
 
 
 Camp::Camp(const Point& pos, const int& treasury): 
-    GameElement(pos, sprite_->getSize()), treasuryDisplayer_(Point{pos.getX(), pos.getY() + sprite_->getHeight() / 2}, treasury), treasury_(treasury)
+    GameElement(pos, getSpriteSize(sprite_)), treasuryDisplayer_(Point{pos.getX(), pos.getY() + getSpriteSize(sprite_).getHeight() / 2}, treasury), treasury_(treasury)
 {
     treasuryDisplayer_.setNoIncome(true);
 }
@@ -27,7 +27,7 @@ void Castle::quit()
 }
 
 
-Castle::Castle(const Point& pos): GameElement(pos, sprite_->getSize()) {}
+Castle::Castle(const Point& pos): GameElement(pos, getSpriteSize(sprite_)) {}
 
 void Castle::display(const std::weak_ptr<BlitTarget>& target) const {
     auto ltarget = target.lock();
@@ -1,7 +1,31 @@
 #include "GameElements/GameElement.hpp"
+#include "GameElements/Town.hpp"
+#include "GameElements/Castle.hpp"
+#include "GameElements/Camp.hpp"
+#include "GameElements/Troops/Villager.hpp"
+#include "GameElements/Troops/Pikeman.hpp"
+#include "GameElements/Troops/Knight.hpp"
+#include "GameElements/Troops/Hero.hpp"
+#include "GameElements/Troops/Bandit.hpp"
 
 GameElement::GameElement(const Point& pos, const Size& size): Displayer(pos, size) {
     auto lrenderer = renderer_.lock();
-    if (!lrenderer)
+    if (!lrenderer && !headless_)
         throw std::runtime_error("Displayer not initialized");
 }
+
+char GameElement::getLetter(const std::shared_ptr<GameElement>& elt) {
+    if (Town::is(elt))          return 'T';
+    else if (Castle::is(elt))   return 'C';
+    else if (Camp::is(elt))     return 'A';
+    else if (Villager::is(elt)) return 'V';
+    else if (Pikeman::is(elt))  return 'P';
+    else if (Knight::is(elt))   return 'K';
+    else if (Hero::is(elt))     return 'H';
+    else if (Bandit::is(elt))   return 'B';
+    return '.';
+}
+
+Size GameElement::getSpriteSize(const std::shared_ptr<Texture>& sprite) {
+    return sprite ? sprite->getSize() : Size{0, 0};
+}
@@ -29,7 +29,8 @@ void Player::quit()
 }
 
 
-Player::Player(const GroundColor& color) : color_(color), plate_(plateDisplayer_.copy()), lostPlate_(plateDisplayer_.copy()) {
+// Plates share the atlas of plateDisplayer_, tinted when drawn
+Player::Player(const GroundColor& color) : color_(color), plate_(plateDisplayer_), lostPlate_(plateDisplayer_) {
     plate_.colorize(color.owned);
     lostPlate_.colorize(color.available);
 }
@@ -46,34 +47,34 @@ HexagonDisplayer& Player::getLostPlate() {
 }
 
 void Player::addTownCell(std::weak_ptr<PlayableGround> townCell) {
-    if (!townCell.expired()) {
-        allTownCells_.push_back(townCell);
-        townCells_.push_back(townCell);
-    }
+    auto ltownCell = townCell.lock();
+    if (!ltownCell) return;
+
+    // Already added
+    for (auto& cell : townCells_)
+        if (cell.lock() == ltownCell)
+            return;
+
+    townCells_.push_back(townCell);
 }
 
-void Player::updateTowns() {
-    townCells_ = allTownCells_;
-    std::erase_if(townCells_, [](const auto& townCell) {
-        auto ltownCell = townCell.lock();
-        return ltownCell ? !Town::is(ltownCell->getElement()) : true;
+void Player::removeTownCell(const PlayableGround* townCell) {
+    // Keep the order of the others (it orders the sharing of deficits)
+    std::erase_if(townCells_, [townCell](const auto& cell) {
+        auto lcell = cell.lock();
+        return !lcell || lcell.get() == townCell;
     });
 }
 
-const bool Player::hasTowns() {
-    // Remove destroyed towns
-    updateTowns();
-
-    for (auto& townCell : townCells_)
-        if (auto ltownCell = townCell.lock())
-            if (Town::cast(ltownCell->getElement()))
-                return true;
+void Player::clearTownCells() {
+    townCells_.clear();
+}
 
-    return false;
+const bool Player::hasTowns() const {
+    return !townCells_.empty();
 }
 
-std::vector<std::weak_ptr<PlayableGround>> Player::getTownCells() {
-    updateTowns();
+std::span<const std::weak_ptr<PlayableGround>> Player::getTownCells() const {
     return townCells_;
 }
 
@@ -91,8 +92,6 @@ void Player::onTurnStart() {
 }
 
 void Player::onTurnEnd() {
-    updateTowns();
-
     // Unselect towns
     for (auto& townCell : townCells_)
         if (auto ltownCell = townCell.lock())
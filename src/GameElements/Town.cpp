@@ -31,7 +31,7 @@ void Town::quit()
 
 
 Town::Town(const Point& pos, const int& treasury)
-    : GameElement(pos, sprite_->getSize()), treasuryDisplayer_(Point{pos.getX(), pos.getY() + sprite_->getHeight() / 2}, treasury), treasury_(treasury)
+    : GameElement(pos, getSpriteSize(sprite_)), treasuryDisplayer_(Point{pos.getX(), pos.getY() + getSpriteSize(sprite_).getHeight() / 2}, treasury), treasury_(treasury)
 {}
 
 void Town::setPos(const Point& pos) {
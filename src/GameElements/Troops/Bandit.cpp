@@ -27,7 +27,7 @@ void Bandit::quit()
 }
 
 
-Bandit::Bandit(const Point& pos): Troop(pos, sprite_->getSize()) {}
+Bandit::Bandit(const Point& pos): Troop(pos, getSpriteSize(sprite_)) {}
 
 void Bandit::display(const std::weak_ptr<BlitTarget>& target) const {
     Troop::displaySprite(target, sprite_);
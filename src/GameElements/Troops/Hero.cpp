@@ -27,7 +27,7 @@ void Hero::quit()
 }
 
 
-Hero::Hero(const Point& pos): Troop(pos, sprite_->getSize()) {}
+Hero::Hero(const Point& pos): Troop(pos, getSpriteSize(sprite_)) {}
 
 void Hero::display(const std::weak_ptr<BlitTarget>& target) const {
     Troop::displaySprite(target, sprite_);
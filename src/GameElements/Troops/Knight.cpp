@@ -27,7 +27,7 @@ void Knight::quit()
 }
 
 
-Knight::Knight(const Point& pos): Troop(pos, sprite_->getSize()) {}
+Knight::Knight(const Point& pos): Troop(pos, getSpriteSize(sprite_)) {}
 
 void Knight::display(const std::weak_ptr<BlitTarget>& target) const {
     Troop::displaySprite(target, sprite_);
@@ -28,7 +28,7 @@ void Pikeman::quit()
 }
 
 
-Pikeman::Pikeman(const Point& pos): Troop(pos, sprite_->getSize()) {}
+Pikeman::Pikeman(const Point& pos): Troop(pos, getSpriteSize(sprite_)) {}
 
 void Pikeman::display(const std::weak_ptr<BlitTarget>& target) const {
     Troop::displaySprite(target, sprite_);
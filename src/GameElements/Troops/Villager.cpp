@@ -27,7 +27,7 @@ void Villager::quit()
 }
 
 
-Villager::Villager(const Point& pos): Troop(pos, sprite_->getSize()) {}
+Villager::Villager(const Point& pos): Troop(pos, getSpriteSize(sprite_)) {}
 
 void Villager::display(const std::weak_ptr<BlitTarget>& target) const {
     Troop::displaySprite(target, sprite_);
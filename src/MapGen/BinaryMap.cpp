@@ -0,0 +1,81 @@
+#include "MapGen/BinaryMap.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+    constexpr char MAGIC[4] = {'K', 'M', 'A', 'P'};
+    constexpr std::uint8_t VERSION = 1;
+    constexpr size_t HEADER_SIZE = sizeof(MAGIC) + 1 + 4 + 4;
+
+    std::uint32_t readInt(const char* data) {
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; i++)
+            value |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+        return value;
+    }
+
+    void writeInt(std::string& out, std::uint32_t value) {
+        for (int i = 0; i < 4; i++)
+            out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    /// Read and check the header, then return the size of the map (positive)
+    std::pair<int, int> readHeader(std::ifstream& in, const std::string& path) {
+        char header[HEADER_SIZE];
+        if (!in.read(header, HEADER_SIZE) || std::string(header, sizeof(MAGIC)) != std::string(MAGIC, sizeof(MAGIC)))
+            throw std::runtime_error("Fichier de map binaire invalide: " + path);
+        if (static_cast<std::uint8_t>(header[sizeof(MAGIC)]) != VERSION)
+            throw std::runtime_error("Version de map binaire non supportée: " + path);
+
+        int width = static_cast<int>(readInt(header + sizeof(MAGIC) + 1));
+        int height = static_cast<int>(readInt(header + sizeof(MAGIC) + 5));
+        if (width <= 0 || height <= 0)
+            throw std::runtime_error("Fichier de map binaire invalide: " + path);
+
+        return {width, height};
+    }
+}
+
+const bool BinaryMap::isBinary(const std::string& path) {
+    return std::filesystem::path(path).extension() == EXTENSION;
+}
+
+std::pair<int, int> BinaryMap::readSize(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Impossible d'ouvrir le fichier de map: " + path);
+    return readHeader(in, path);
+}
+
+BinaryMap BinaryMap::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Impossible d'ouvrir le fichier de map: " + path);
+
+    BinaryMap map;
+    std::tie(map.width, map.height) = readHeader(in, path);
+
+    // Cells in a single read
+    map.cells.resize(static_cast<size_t>(map.width) * map.height * 2);
+    if (!in.read(map.cells.data(), static_cast<std::streamsize>(map.cells.size())))
+        throw std::runtime_error("Fichier de map binaire tronqué: " + path);
+
+    return map;
+}
+
+void BinaryMap::save(const std::string& path) const {
+    if (cells.size() != static_cast<size_t>(width) * height * 2)
+        throw std::runtime_error("Taille des cases incohérente pour la map: " + path);
+
+    std::string header(MAGIC, sizeof(MAGIC));
+    header += static_cast<char>(VERSION);
+    writeInt(header, static_cast<std::uint32_t>(width));
+    writeInt(header, static_cast<std::uint32_t>(height));
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out || !out.write(header.data(), static_cast<std::streamsize>(header.size()))
+             || !out.write(cells.data(), static_cast<std::streamsize>(cells.size())))
+        throw std::runtime_error("Impossible d'écrire la map: " + path);
+}
@@ -0,0 +1,318 @@
+#include "MapGen/MapGenerator.hpp"
+#include "Utils/HexagonUtils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <stdexcept>
+
+namespace {
+    /// Axial directions of the neighbors of a hexagon
+    constexpr int DIRECTIONS[6][2] = {{1, 0}, {1, -1}, {0, -1}, {-1, 0}, {-1, 1}, {0, 1}};
+
+    /// Maximum number of octaves of the noise
+    constexpr int MAX_OCTAVES = 6;
+
+    /// Candidates tried when placing a player
+    constexpr size_t START_CANDIDATES = 4096;
+
+    /// Random value in [0, 1) of a lattice point (splitmix64 finalizer)
+    double latticeValue(int x, int y, std::uint64_t salt) {
+        std::uint64_t z = salt ^ (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) ^ static_cast<std::uint32_t>(y);
+        z += 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        return static_cast<double>(z >> 11) / static_cast<double>(1ULL << 53);
+    }
+
+    double smoothstep(double t) {
+        return t * t * (3 - 2 * t);
+    }
+
+    /// Distance between two hexagons in offset coordinates
+    int hexDistance(int x1, int y1, int x2, int y2) {
+        auto [q1, r1] = HexagonUtils::offsetToAxial(x1, y1);
+        auto [q2, r2] = HexagonUtils::offsetToAxial(x2, y2);
+        return (std::abs(q1 - q2) + std::abs(r1 - r2) + std::abs(q1 + r1 - q2 - r2)) / 2;
+    }
+}
+
+MapGenerator::MapGenerator(const MapGeneratorConfig& config) : config_(config) {
+    if (config_.width < 2 || config_.height < 2)
+        throw std::runtime_error("Une map doit au moins être de taille 2x2.");
+    if (config_.players < 1 || config_.players > 9)
+        throw std::runtime_error("Le nombre de joueurs doit être entre 1 et 9.");
+    if (config_.water < 0 || config_.water >= 1 || config_.forests < 0 || config_.forests >= 1)
+        throw std::runtime_error("Les proportions d'eau et de forêts doivent être dans [0, 1).");
+
+    map_.width = config_.width;
+    map_.height = config_.height;
+    map_.cells.assign(static_cast<size_t>(map_.width) * map_.height * 2, '.');
+
+    generateTerrain();
+    placePlayers(largestLand());
+    placeNeutrals();
+}
+
+const BinaryMap& MapGenerator::getMap() const {
+    return map_;
+}
+
+double MapGenerator::noise(int x, int y, unsigned int layer) const {
+    // Position of the center of the hexagon (odd rows shifted by half a cell)
+    double px = x + 0.5 * (y & 1);
+    double py = y * std::sqrt(3) / 2;
+
+    // Fractal sum of octaves, from continents to a few cells
+    double period = std::max(8.0, std::max(map_.width, map_.height) / 3.0);
+    double value = 0;
+    double amplitude = 1;
+    double total = 0;
+    for (int octave = 0; octave < MAX_OCTAVES && period >= 2; octave++) {
+        std::uint64_t salt = (static_cast<std::uint64_t>(config_.seed) << 32) ^ (static_cast<std::uint64_t>(layer) << 8) ^ octave;
+        double fx = px / period;
+        double fy = py / period;
+        int ix = static_cast<int>(std::floor(fx));
+        int iy = static_cast<int>(std::floor(fy));
+        double tx = smoothstep(fx - ix);
+        double ty = smoothstep(fy - iy);
+
+        double top = latticeValue(ix, iy, salt) * (1 - tx) + latticeValue(ix + 1, iy, salt) * tx;
+        double bottom = latticeValue(ix, iy + 1, salt) * (1 - tx) + latticeValue(ix + 1, iy + 1, salt) * tx;
+        value += amplitude * (top * (1 - ty) + bottom * ty);
+
+        total += amplitude;
+        amplitude *= 0.5;
+        period /= 2;
+    }
+
+    return value / total;
+}
+
+std::vector<std::pair<int, int>> MapGenerator::neighbors(int x, int y) const {
+    std::vector<std::pair<int, int>> result;
+    auto [q, r] = HexagonUtils::offsetToAxial(x, y);
+    for (auto& dir : DIRECTIONS) {
+        auto [nx, ny] = HexagonUtils::axialToOffset(q + dir[0], r + dir[1]);
+        if (nx >= 0 && ny >= 0 && nx < map_.width && ny < map_.height)
+            result.emplace_back(nx, ny);
+    }
+    return result;
+}
+
+void MapGenerator::setCell(int x, int y, char cell, char element) {
+    size_t i = (static_cast<size_t>(y) * map_.width + x) * 2;
+    map_.cells[i] = cell;
+    map_.cells[i + 1] = element;
+}
+
+char MapGenerator::getCell(int x, int y) const {
+    return map_.cells[(static_cast<size_t>(y) * map_.width + x) * 2];
+}
+
+void MapGenerator::generateTerrain() {
+    const int w = map_.width;
+    const int h = map_.height;
+    std::vector<double> elevation(static_cast<size_t>(w) * h);
+    std::vector<double> woods(elevation.size());
+
+    // Elevation sinking near the borders, so that the map is made of islands
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            double dx = std::abs(2.0 * x / (w - 1) - 1);
+            double dy = std::abs(2.0 * y / (h - 1) - 1);
+            double border = std::pow(std::max(dx, dy), 3);
+
+            size_t i = static_cast<size_t>(y) * w + x;
+            elevation[i] = noise(x, y, 0) - 0.5 * border;
+            woods[i] = noise(x, y, 1);
+        }
+    }
+
+    // Thresholds giving the requested shares of water and forests
+    auto quantile = [](std::vector<double> values, double share) {
+        if (values.empty() || share <= 0) return -std::numeric_limits<double>::infinity();
+        size_t n = std::min(values.size() - 1, static_cast<size_t>(share * values.size()));
+        std::nth_element(values.begin(), values.begin() + n, values.end());
+        return values[n];
+    };
+    double seaLevel = quantile(elevation, config_.water);
+
+    std::vector<double> landWoods;
+    for (size_t i = 0; i < elevation.size(); i++)
+        if (elevation[i] >= seaLevel) landWoods.push_back(woods[i]);
+    double treeLine = config_.forests > 0 ? quantile(landWoods, 1 - config_.forests) : std::numeric_limits<double>::infinity();
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            size_t i = static_cast<size_t>(y) * w + x;
+            if (elevation[i] < seaLevel) setCell(x, y, 'W', '.');
+            else if (woods[i] > treeLine) setCell(x, y, 'F', '.');
+            else setCell(x, y, '0', '.');
+        }
+    }
+}
+
+std::vector<int> MapGenerator::largestLand() const {
+    const int w = map_.width;
+    std::vector<bool> visited(static_cast<size_t>(w) * map_.height, false);
+    std::vector<int> largest;
+
+    // Flood each island of playable cells
+    for (int start = 0; start < static_cast<int>(visited.size()); start++) {
+        if (visited[start] || getCell(start % w, start / w) != '0') continue;
+
+        std::vector<int> island;
+        std::queue<int> queue;
+        queue.push(start);
+        visited[start] = true;
+        while (!queue.empty()) {
+            int i = queue.front();
+            queue.pop();
+            island.push_back(i);
+
+            for (auto [nx, ny] : neighbors(i % w, i / w)) {
+                int ni = ny * w + nx;
+                if (!visited[ni] && getCell(nx, ny) == '0') {
+                    visited[ni] = true;
+                    queue.push(ni);
+                }
+            }
+        }
+
+        if (island.size() > largest.size())
+            largest = std::move(island);
+    }
+
+    return largest;
+}
+
+void MapGenerator::placePlayers(const std::vector<int>& land) {
+    const int w = map_.width;
+    if (static_cast<int>(land.size()) < config_.players * 2)
+        throw std::runtime_error("Pas assez de terre pour " + std::to_string(config_.players) + " joueurs.");
+
+    std::mt19937 gen(config_.seed);
+    std::uniform_int_distribution<size_t> pick(0, land.size() - 1);
+
+    // Starts as far as possible from each other (farthest point sampling)
+    std::vector<int> starts{land[pick(gen)]};
+    while (static_cast<int>(starts.size()) < config_.players) {
+        int best = -1;
+        int bestDistance = -1;
+        for (size_t c = 0; c < std::min(START_CANDIDATES, land.size()); c++) {
+            int candidate = land.size() <= START_CANDIDATES ? land[c] : land[pick(gen)];
+            int distance = std::numeric_limits<int>::max();
+            for (int start : starts)
+                distance = std::min(distance, hexDistance(candidate % w, candidate / w, start % w, start / w));
+
+            if (distance > bestDistance) {
+                bestDistance = distance;
+                best = candidate;
+            }
+        }
+        starts.push_back(best);
+    }
+
+    // Territory, town and villager of each player
+    std::vector<int> towns;
+    for (int p = 0; p < config_.players; p++) {
+        char owner = static_cast<char>('1' + p);
+        int start = starts[p];
+
+        // Start claimed by an earlier territory: take the free cell farthest from the towns
+        if (getCell(start % w, start / w) != '0') {
+            int bestDistance = -1;
+            for (int candidate : land) {
+                if (getCell(candidate % w, candidate / w) != '0') continue;
+
+                int distance = std::numeric_limits<int>::max();
+                for (int town : towns)
+                    distance = std::min(distance, hexDistance(candidate % w, candidate / w, town % w, town / w));
+
+                if (distance > bestDistance) {
+                    bestDistance = distance;
+                    start = candidate;
+                }
+            }
+
+            if (bestDistance == -1)
+                throw std::runtime_error("Pas de case libre pour le joueur " + std::to_string(p + 1) + ".");
+        }
+        towns.push_back(start);
+
+        std::queue<std::pair<int, int>> queue;
+        queue.emplace(start, 0);
+        setCell(start % w, start / w, owner, 'T');
+        bool villager = false;
+        while (!queue.empty()) {
+            auto [i, distance] = queue.front();
+            queue.pop();
+            if (distance >= config_.territoryRadius) continue;
+
+            for (auto [nx, ny] : neighbors(i % w, i / w)) {
+                if (getCell(nx, ny) != '0') continue;
+
+                setCell(nx, ny, owner, villager ? '.' : 'V');
+                villager = true;
+                queue.emplace(ny * w + nx, distance + 1);
+            }
+        }
+    }
+}
+
+void MapGenerator::placeNeutrals() {
+    const int w = map_.width;
+    std::mt19937 gen(config_.seed ^ 0x5bd1e995u);
+
+    // Free neutral cells, in random order
+    std::vector<int> free;
+    for (int i = 0; i < map_.width * map_.height; i++)
+        if (getCell(i % w, i / w) == '0') free.push_back(i);
+    std::shuffle(free.begin(), free.end(), gen);
+
+    size_t nbCamps = std::min(free.size(), static_cast<size_t>(std::lround(free.size() * config_.camps)));
+    size_t nbBandits = std::min(free.size() - nbCamps, static_cast<size_t>(std::lround(free.size() * config_.bandits)));
+
+    // Camps with 1 to 5 coins, then bandits
+    std::uniform_int_distribution<int> coins(0, 4);
+    for (size_t c = 0; c < nbCamps; c++)
+        setCell(free[c] % w, free[c] / w, static_cast<char>('a' + coins(gen)), '.');
+    for (size_t b = nbCamps; b < nbCamps + nbBandits; b++)
+        setCell(free[b] % w, free[b] / w, '0', 'B');
+}
+
+void MapGenerator::saveAscii(const std::string& path) const {
+    std::ofstream out{path};
+    if (!out)
+        throw std::runtime_error("Impossible d'ouvrir le fichier en écriture: " + path);
+
+    std::string line;
+    for (int y = 0; y < map_.height; y++) {
+        line.clear();
+        for (int x = 0; x < map_.width; x++) {
+            size_t i = (static_cast<size_t>(y) * map_.width + x) * 2;
+            if (x) line += ' ';
+            line.append(map_.cells, i, 2);
+        }
+        line += '\n';
+        out.write(line.data(), static_cast<std::streamsize>(line.size()));
+    }
+
+    if (!out)
+        throw std::runtime_error("Impossible d'écrire la map: " + path);
+}
+
+void MapGenerator::saveBinary(const std::string& path) const {
+    map_.save(path);
+}
+
+void MapGenerator::save(const std::string& path) const {
+    if (BinaryMap::isBinary(path)) saveBinary(path);
+    else saveAscii(path);
+}
@@ -0,0 +1,71 @@
+#include "MapGen/MapGenerator.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    void printUsage() {
+        std::cout << "Usage: konkr-mapgen [options] output.(ascii|kmap)\n"
+                  << "  --size WxH        Size of the map in cells (default: 64x64)\n"
+                  << "  --players N       Number of players, 1 to 9 (default: 4)\n"
+                  << "  --seed N          Seed of the map (default: 0)\n"
+                  << "  --water R         Share of water cells (default: 0.35)\n"
+                  << "  --forests R       Share of land cells with forests (default: 0.10)\n"
+                  << "  --camps R         Camps per land cell (default: 0.004)\n"
+                  << "  --bandits R       Bandits per land cell (default: 0.006)\n"
+                  << "  --territory N     Radius of the starting territories (default: 2)\n"
+                  << "The format is chosen from the extension: .kmap is binary, anything else is ASCII.\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    MapGeneratorConfig config;
+    std::string output;
+
+    try {
+        // Read arguments
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            auto next = [&]() -> std::string {
+                if (i + 1 >= argc) throw std::runtime_error("Valeur manquante pour " + arg);
+                return argv[++i];
+            };
+
+            if (arg == "--help" || arg == "-h") { printUsage(); return 0; }
+            else if (arg == "--size") {
+                std::string size = next();
+                auto sep = size.find('x');
+                if (sep == std::string::npos) throw std::runtime_error("Taille invalide, attendu LxH: " + size);
+                config.width = std::stoi(size.substr(0, sep));
+                config.height = std::stoi(size.substr(sep + 1));
+            }
+            else if (arg == "--players") config.players = std::stoi(next());
+            else if (arg == "--seed") config.seed = static_cast<unsigned int>(std::stoul(next()));
+            else if (arg == "--water") config.water = std::stod(next());
+            else if (arg == "--forests") config.forests = std::stod(next());
+            else if (arg == "--camps") config.camps = std::stod(next());
+            else if (arg == "--bandits") config.bandits = std::stod(next());
+            else if (arg == "--territory") config.territoryRadius = std::stoi(next());
+            else if (arg.rfind("--", 0) == 0) throw std::runtime_error("Option inconnue: " + arg);
+            else output = arg;
+        }
+        if (output.empty())
+            throw std::runtime_error("Fichier de sortie manquant.");
+
+        auto start = std::chrono::steady_clock::now();
+        MapGenerator generator{config};
+        generator.save(output);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << config.width << "x" << config.height << " (" << config.players << " joueurs) -> "
+                  << output << " en " << ms << " ms" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        printUsage();
+        return 1;
+    }
+}
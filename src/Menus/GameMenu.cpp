@@ -9,6 +9,10 @@
 #include "SDLWrappers/Cursor.hpp"
 #include "Menus/MapsMenu.hpp"
 #include "Utils/HexagonUtils.hpp"
+#include "Profiling/ProfileScope.hpp"
+
+#include <filesystem>
+#include <stdexcept>
 
 GameMenu::GameMenu(const std::shared_ptr<Window>& window, const std::string& mapPath): MenuBase{window} {
     windowSize_ = window_->getSize();
@@ -18,8 +22,24 @@ GameMenu::GameMenu(const std::shared_ptr<Window>& window, const std::string& map
     maxHexSize_ = windowSize_ * 0.13;
 
     // Create map
-    createMap(mapPath);
+    createMap(mapPath, GameMap::randomSeed());
+    createWidgets();
+}
+
+GameMenu::GameMenu(const std::shared_ptr<Window>& window, const Replay& replay, int replayDelay): MenuBase{window}, replayDelay_(replayDelay) {
+    windowSize_ = window_->getSize();
+
+    // Init variables
+    minHexSize_ = windowSize_ * 0.03;
+    maxHexSize_ = windowSize_ * 0.13;
+
+    // Create map in the initial state of the replay
+    replayPlayer_ = std::make_unique<ReplayPlayer>(replay);
+    createMap(replay.getMapFile(), replay.getSeed());
+    createWidgets();
+}
 
+void GameMenu::createWidgets() {
     // Create Overlay
     overlay_ = std::make_unique<Overlay>(Point{0, 0});
     overlay_->setPos(Point{windowSize_.getWidth() / 2, windowSize_.getHeight() - overlay_->getHeight() / 2});
@@ -39,11 +59,14 @@ GameMenu::GameMenu(const std::shared_ptr<Window>& window, const std::string& map
         nextMenu_ = std::make_shared<MapsMenu>(window_);
         loop_ = false; 
     });
+
+    // Create profiler panel
+    profiler_ = std::make_unique<ProfilerDisplayer>(Point{10, 10});
 }
 
-void GameMenu::createMap(const std::string& mapPath) {
+void GameMenu::createMap(const std::string& mapPath, unsigned int seed) {
     // Create map
-    map_ = std::make_unique<GameMap>(Point{0, 0}, windowSize_ * 0.75, mapPath);
+    map_ = std::make_unique<GameMap>(Point{0, 0}, windowSize_ * 0.75, mapPath, seed);
 
     // Define utils variables
     mapCellSize_ = Size{map_->getWidth(), map_->getHeight()};
@@ -90,9 +113,47 @@ void GameMenu::updateShop() {
     overlay_->update(map_->getMaxTreasuryOfCurrentPlayer());
 }
 
+void GameMenu::stepReplay() {
+    if (!replayPlayer_ || replayPlayer_->isFinished()) return;
+
+    Uint32 currentTime = SDL_GetTicks();
+    if (replayDelay_ > 0 && currentTime - lastReplayStep_ < static_cast<Uint32>(replayDelay_)) return;
+    lastReplayStep_ = currentTime;
+
+    try {
+        // Play one action, or everything without delay
+        if (replayDelay_ > 0) replayPlayer_->step(*map_);
+        else replayPlayer_->playAll(*map_);
+    } catch (const std::runtime_error& e) {
+        // Desynchronized replay: back to the maps
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", e.what());
+        nextMenu_ = std::make_shared<MapsMenu>(window_);
+        loop_ = false;
+        return;
+    }
+
+    map_->refresh();
+    updateShop();
+}
+
+void GameMenu::saveReplay() const {
+    const Replay& replay = map_->getReplay();
+    if (replayPlayer_ || replay.getActions().empty()) return;
+
+    try {
+        std::filesystem::create_directories("replays");
+        std::string path = "replays/" + std::filesystem::path(replay.getMapFile()).stem().string() + "-" + std::to_string(replay.getSeed()) + ".krpl";
+        replay.save(path);
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Replay: %s", path.c_str());
+    } catch (const std::exception& e) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", e.what());
+    }
+}
+
 const bool GameMenu::handleOverlay(SDL_Event& event) {
-    overlay_->handleEvent(event);
     backBtn_->handleEvent(event);
+    if (replayPlayer_) return false;
+    overlay_->handleEvent(event);
 
     // If return to MapsMenu
     if (overlay_->undoRequested()) {
@@ -124,7 +185,9 @@ void GameMenu::onMouseButtonDown(SDL_Event& event) {
     if (overlay_->isHover(mp) || backBtn_->isHover(mp))
         return;
 
-    map_->handleEvent(event);
+    // The replay plays alone
+    if (!replayPlayer_)
+        map_->handleEvent(event);
     if (map_->hasTroopSelected())
         return;
     
@@ -148,7 +211,8 @@ void GameMenu::onMouseMotion(SDL_Event& event) {
 }
 
 void GameMenu::onMouseButtonUp(SDL_Event& event) {
-    map_->handleEvent(event);
+    if (!replayPlayer_)
+        map_->handleEvent(event);
     moveOrigin_.reset();
     updateShop();
 }
@@ -167,7 +231,9 @@ void GameMenu::onMouseWheel(SDL_Event& event) {
 }
 
 void GameMenu::onKeyDown(SDL_Event& event) {
-    if (event.key.keysym.sym == SDLK_RETURN) {
+    if (replayPlayer_ && (event.key.keysym.sym == SDLK_RETURN || event.key.keysym.sym == SDLK_z)) {
+        return;
+    } else if (event.key.keysym.sym == SDLK_RETURN) {
         if (!map_->hasTroopSelected()) {
             map_->nextPlayer();
             updateShop();
@@ -197,50 +263,89 @@ void GameMenu::onKeyDown(SDL_Event& event) {
 void GameMenu::handleEvents(){
     SDL_Event event;
 
-    while (SDL_PollEvent(&event)) {
-        handleEvent(event);
+    // Only the last motion of the frame is handled, with the moves of the previous ones
+    std::optional<SDL_Event> motion;
 
-        // If game finished
-        if (gameFinished_) {
-            finishBtn_->handleEvent(event);
+    while (SDL_PollEvent(&event)) {
+        if (event.type == SDL_MOUSEMOTION) {
+            if (motion) {
+                event.motion.xrel += motion->motion.xrel;
+                event.motion.yrel += motion->motion.yrel;
+            }
+            motion = event;
             continue;
         }
 
-        // Handle event of overlay
-        if (handleOverlay(event)) {
-            updateShop();
-            continue;
+        // Keep the order: the pending motion happened before this event
+        if (motion) {
+            dispatchEvent(*motion);
+            motion.reset();
         }
-        
-        // handle event of menu
-        if (event.type == SDL_MOUSEBUTTONDOWN)
-            onMouseButtonDown(event);
-        else if (event.type == SDL_MOUSEMOTION)
-            onMouseMotion(event);
-        else if (event.type == SDL_MOUSEBUTTONUP)
-            onMouseButtonUp(event);
-        else if (event.type == SDL_MOUSEWHEEL)
-            onMouseWheel(event);
-        else if (event.type == SDL_KEYDOWN)
-            onKeyDown(event);
+        dispatchEvent(event);
     }
+
+    if (motion)
+        dispatchEvent(*motion);
     Cursor::update();
 }
 
+void GameMenu::dispatchEvent(SDL_Event& event) {
+    handleEvent(event);
+
+    // If game finished
+    if (gameFinished_) {
+        finishBtn_->handleEvent(event);
+        return;
+    }
+
+    // Handle event of overlay
+    if (handleOverlay(event)) {
+        updateShop();
+        return;
+    }
+    
+    // handle event of menu
+    if (event.type == SDL_MOUSEBUTTONDOWN)
+        onMouseButtonDown(event);
+    else if (event.type == SDL_MOUSEMOTION)
+        onMouseMotion(event);
+    else if (event.type == SDL_MOUSEBUTTONUP)
+        onMouseButtonUp(event);
+    else if (event.type == SDL_MOUSEWHEEL)
+        onMouseWheel(event);
+    else if (event.type == SDL_KEYDOWN)
+        onKeyDown(event);
+}
+
 void GameMenu::draw() {
     window_->fill(ColorUtils::SEABLUE);
-    
-    map_->display(window_);
-    overlay_->display(window_);
-    backBtn_->display(window_);
 
-    if (gameFinished_) {
-        window_->darken();
-        window_->blit(finishTex_, (windowSize_ - finishTex_->getSize()) / 2);
-        finishBtn_->display(window_);
+    {
+        ProfileScope scope{"map"};
+        map_->display(window_);
+    }
+
+    {
+        ProfileScope scope{"overlay"};
+        overlay_->display(window_);
+        backBtn_->display(window_);
+
+        if (gameFinished_) {
+            window_->darken();
+            window_->blit(finishTex_, (windowSize_ - finishTex_->getSize()) / 2);
+            finishBtn_->display(window_);
+        }
+    }
+
+    if (FrameProfiler::isEnabled()) {
+        profiler_->update();
+        profiler_->display(window_);
     }
 
-    window_->refresh();
+    {
+        ProfileScope scope{"present"};
+        window_->refresh();
+    }
     frameCount_++;
 
     Uint32 currentTime = SDL_GetTicks();
@@ -257,16 +362,24 @@ std::shared_ptr<MenuBase> GameMenu::run() {
     loop_ = true;
 
     while (loop_) {
+        FrameProfiler::beginFrame();
+
         // Handle events
-        handleEvents();
-        gameFinished_ = map_->gameFinished();
+        {
+            ProfileScope scope{"events"};
+            handleEvents();
+            stepReplay();
+            gameFinished_ = map_->gameFinished();
+        }
 
         // Draw elements
         draw();
+        FrameProfiler::endFrame();
 
         // Control loop duration
         SDL_Delay(1/60);
     }
 
+    saveReplay();
     return nextMenu_;
 }
@@ -9,6 +9,7 @@
 #include "SDLWrappers/Cursor.hpp"
 #include "Menus/MainMenu.hpp"
 #include "Utils/HexagonUtils.hpp"
+#include "Profiling/ProfileScope.hpp"
 #include "Cells/Grounds/PlayableGround.hpp"
 #include "Cells/Water.hpp"
 #include "Cells/Grounds/Forest.hpp"
@@ -44,6 +45,9 @@ MakeMenu::MakeMenu(const std::shared_ptr<Window>& window): MenuBase{window} {
     backBtn_ = std::make_unique<Button>(Point{0, 0}, "../assets/img/buttons/back_btn.png", "../assets/img/buttons/back_btn_hover.png", "../assets/img/buttons/back_btn_pressed.png");
     backBtn_->setPos(Point{backBtn_->getWidth() / 2, window_->getHeight() - backBtn_->getHeight() / 2});
     backBtn_->setCallback([this]() { nextMenu_ = std::make_shared<MainMenu>(window_); loop_ = false; });
+
+    // Create profiler panel
+    profiler_ = std::make_unique<ProfilerDisplayer>(Point{10, 10});
 }
 
 void MakeMenu::createMap(const std::string& mapPath) {
@@ -229,19 +233,37 @@ void MakeMenu::handleEvents(){
             onMouseButtonUp(event);
         else if (event.type == SDL_MOUSEWHEEL)
             onMouseWheel(event);
-        else if (event.type == SDL_KEYDOWN)
+        else if (event.type == SDL_KEYDOWN) {
+            // Cells may be edited in place
             onKeyDown(event);
+            map_->refresh();
+        }
     }
     Cursor::update();
 }
 
 void MakeMenu::draw() {
     window_->fill(ColorUtils::SEABLUE);
-    
-    map_->display(window_);
-    backBtn_->display(window_);
 
-    window_->refresh();
+    {
+        ProfileScope scope{"map"};
+        map_->display(window_);
+    }
+
+    {
+        ProfileScope scope{"overlay"};
+        backBtn_->display(window_);
+    }
+
+    if (FrameProfiler::isEnabled()) {
+        profiler_->update();
+        profiler_->display(window_);
+    }
+
+    {
+        ProfileScope scope{"present"};
+        window_->refresh();
+    }
     frameCount_++;
 
     Uint32 currentTime = SDL_GetTicks();
@@ -257,11 +279,17 @@ std::shared_ptr<MenuBase> MakeMenu::run() {
     loop_ = true;
 
     while (loop_) {
+        FrameProfiler::beginFrame();
+
         // Handle events
-        handleEvents();
+        {
+            ProfileScope scope{"events"};
+            handleEvents();
+        }
 
         // Draw elements
         draw();
+        FrameProfiler::endFrame();
 
         // Control loop duration
         SDL_Delay(1/60);
@@ -5,6 +5,8 @@
 #include "Menus/GameMenu.hpp"
 #include "Utils/Checker.hpp"
 #include "SDLWrappers/Cursor.hpp"
+#include "MapGen/MapGenerator.hpp"
+#include "Widgets/GameMap.hpp"
 #include <filesystem>
 
 namespace fs = std::filesystem;
@@ -12,30 +14,34 @@ namespace fs = std::filesystem;
 MapsMenu::MapsMenu(const std::shared_ptr<Window>& window) : MenuBase{window}
 {
     // Set filepaths
-    const fs::path mapsDir   = "../assets/map/";
-    const fs::path imagesDir = "../assets/img/map/";
-    std::vector<std::string> mapNames;
+    const fs::path mapsDir      = "../assets/map/";
+    const fs::path generatedDir = "maps/";
+    const fs::path imagesDir    = "../assets/img/map/";
+    std::vector<fs::path> mapFiles;
 
     // Check dir exists
     if (!fs::exists(mapsDir) || !fs::is_directory(mapsDir))
         throw std::runtime_error("Dossier de maps introuvable : " + mapsDir.string());
 
-    // Get names of files
-    for (auto& entry : fs::directory_iterator(mapsDir)) {
-        if (!entry.is_regular_file()) continue;
-        const fs::path& path = entry.path();
-        if (path.extension() != ".ascii") continue;
+    // Get names of files, then those of the generated maps
+    for (const fs::path& dir : {mapsDir, generatedDir}) {
+        if (!fs::is_directory(dir)) continue;
+        for (auto& entry : fs::directory_iterator(dir)) {
+            if (!entry.is_regular_file()) continue;
+            const fs::path& path = entry.path();
+            if (path.extension() != ".ascii" && !BinaryMap::isBinary(path.string())) continue;
 
-        auto stem = path.stem().string();
-        mapNames.push_back(stem);
+            mapFiles.push_back(path);
+        }
     }
-    if (mapNames.empty())
+    if (mapFiles.empty())
         throw std::runtime_error("Aucune map trouvée dans " + mapsDir.string());
 
     // Init maps
-    for (auto const& name : mapNames) {
+    for (auto const& path : mapFiles) {
         // File of map
-        std::string mapFile = (mapsDir / (name + ".ascii")).string();
+        std::string name = path.stem().string();
+        std::string mapFile = path.string();
 
         // Verify if image exists
         fs::path imgPath = imagesDir / (name + ".png");
@@ -56,6 +62,19 @@ MapsMenu::MapsMenu(const std::shared_ptr<Window>& window) : MenuBase{window}
         });
     }
 
+    // Map generated on click, kept in maps/ (listed above) for its replay
+    buttons_.emplace_back(Point{0, 0}, (imagesDir / "unknown_map.png").string());
+    buttons_.back().setCallback([this, window, generatedDir](){
+        MapGeneratorConfig config;
+        config.seed = GameMap::randomSeed();
+        fs::create_directories(generatedDir);
+        std::string mapFile = (generatedDir / ("generated-" + std::to_string(config.seed) + BinaryMap::EXTENSION)).string();
+        MapGenerator{config}.save(mapFile);
+
+        nextMenu_ = std::make_shared<GameMenu>(window, mapFile);
+        loop_ = false;
+    });
+
     // Set pos of buttons
     int nbBtns = buttons_.size();
     int nbLines = std::ceil(nbBtns / 5.);
@@ -1,4 +1,7 @@
 #include "Menus/MenuBase.hpp"
+#include "Profiling/FrameProfiler.hpp"
+
+#include <exception>
 
 void MenuBase::handleEvent(const SDL_Event& e) {
     switch (e.type) {
@@ -6,5 +9,19 @@ void MenuBase::handleEvent(const SDL_Event& e) {
             loop_ = false;
             break;
         }
+        case SDL_KEYDOWN: {
+            // Frame profiler: F3 shows/hides it, F4 exports its trace
+            if (e.key.keysym.sym == SDLK_F3) {
+                FrameProfiler::setEnabled(!FrameProfiler::isEnabled());
+            } else if (e.key.keysym.sym == SDLK_F4) {
+                try {
+                    FrameProfiler::writeTrace("konkr-trace.json");
+                    SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "Trace: konkr-trace.json");
+                } catch (const std::exception& ex) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s", ex.what());
+                }
+            }
+            break;
+        }
     }
 }
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "Profiling/FrameProfiler.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace {
+    /// Frames kept for the percentiles
+    constexpr size_t HISTORY_SIZE = 240;
+
+    /// Scopes kept for the trace (about 24 MB)
+    constexpr size_t MAX_TRACE_EVENTS = 1000000;
+}
+
+bool FrameProfiler::enabled_ = false;
+bool FrameProfiler::inFrame_ = false;
+Uint64 FrameProfiler::frameStart_ = 0;
+Uint64 FrameProfiler::origin_ = 0;
+std::vector<FrameProfiler::Stage> FrameProfiler::stages_;
+std::vector<FrameProfiler::TraceEvent> FrameProfiler::trace_;
+
+void FrameProfiler::setEnabled(bool enabled) {
+    enabled_ = enabled;
+    inFrame_ = false;
+}
+
+const bool FrameProfiler::isEnabled() {
+    return enabled_;
+}
+
+void FrameProfiler::beginFrame() {
+    if (!enabled_) return;
+
+    for (auto& stage : stages_)
+        stage.frameMs = 0;
+    frameStart_ = SDL_GetPerformanceCounter();
+    inFrame_ = true;
+}
+
+void FrameProfiler::endFrame() {
+    if (!enabled_ || !inFrame_) return;
+
+    record("frame", frameStart_, SDL_GetPerformanceCounter());
+    for (auto& stage : stages_) {
+        stage.history.push_back(stage.frameMs);
+        if (stage.history.size() > HISTORY_SIZE)
+            stage.history.pop_front();
+    }
+    inFrame_ = false;
+}
+
+void FrameProfiler::record(const char* name, Uint64 start, Uint64 end) {
+    // Scopes are recorded when they end: an enclosing scope comes after the ones it holds
+    if (!origin_ || start < origin_) origin_ = start;
+
+    if (inFrame_)
+        getStage(name).frameMs += static_cast<double>(end - start) * 1000.0 / SDL_GetPerformanceFrequency();
+    if (trace_.size() < MAX_TRACE_EVENTS)
+        trace_.push_back(TraceEvent{name, start, end});
+}
+
+FrameProfiler::Stage& FrameProfiler::getStage(const char* name) {
+    for (auto& stage : stages_)
+        if (stage.name == name) return stage;
+
+    stages_.push_back(Stage{name, 0, {}});
+    return stages_.back();
+}
+
+std::vector<std::string> FrameProfiler::getStages() {
+    std::vector<std::string> names;
+    for (auto& stage : stages_)
+        names.push_back(stage.name);
+    return names;
+}
+
+const double FrameProfiler::percentile(const std::string& stage, double p) {
+    for (auto& s : stages_) {
+        if (s.name != stage || s.history.empty()) continue;
+
+        std::vector<double> sorted{s.history.begin(), s.history.end()};
+        std::sort(sorted.begin(), sorted.end());
+        size_t i = static_cast<size_t>(std::clamp(p, 0.0, 100.0) / 100.0 * (sorted.size() - 1) + 0.5);
+        return sorted[i];
+    }
+    return 0;
+}
+
+void FrameProfiler::writeTrace(const std::string& path) {
+    std::ofstream out{path};
+    if (!out)
+        throw std::runtime_error("Impossible d'ouvrir le fichier en écriture: " + path);
+
+    // Complete events ("X") in µs, on a single thread
+    double usPerTick = 1e6 / SDL_GetPerformanceFrequency();
+    out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[\n";
+    for (size_t i = 0; i < trace_.size(); i++) {
+        auto& event = trace_[i];
+        out << "{\"name\":\"" << event.name << "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+            << ",\"ts\":" << static_cast<double>(static_cast<std::int64_t>(event.start - origin_)) * usPerTick
+            << ",\"dur\":" << (event.end - event.start) * usPerTick << '}'
+            << (i + 1 < trace_.size() ? ",\n" : "\n");
+    }
+    out << "],\"displayTimeUnit\":\"ms\"}\n";
+
+    if (!out)
+        throw std::runtime_error("Impossible d'écrire la trace: " + path);
+}
+
+void FrameProfiler::reset() {
+    stages_.clear();
+    trace_.clear();
+    origin_ = 0;
+    inFrame_ = false;
+}
@@ -0,0 +1,144 @@
+#include "Rules/Bitboard.hpp"
+#include "Utils/HexagonUtils.hpp"
+
+#include <algorithm>
+
+namespace {
+    /// 64 bits of the words from a bit (zeros outside of the words)
+    inline std::uint64_t bitsAt(const std::vector<std::uint64_t>& words, std::int64_t bit) {
+        std::int64_t word = bit >= 0 ? bit / 64 : (bit - 63) / 64;
+        int shift = static_cast<int>(bit - word * 64);
+        auto at = [&words](std::int64_t i) {
+            return i >= 0 && i < static_cast<std::int64_t>(words.size()) ? words[i] : std::uint64_t{0};
+        };
+
+        std::uint64_t low = at(word) >> shift;
+        return shift ? low | (at(word + 1) << (64 - shift)) : low;
+    }
+}
+
+Bitboard::Bitboard(int width, int height)
+    : width_(width), height_(height), words_((static_cast<size_t>(width) * height + 63) / 64, 0)
+{
+    auto masks = std::make_shared<Masks>();
+    masks->notFirstColumn.assign(words_.size(), 0);
+    masks->notLastColumn.assign(words_.size(), 0);
+    masks->oddRows.assign(words_.size(), 0);
+    masks->evenRows.assign(words_.size(), 0);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int cell = y * width + x;
+            std::uint64_t bit = std::uint64_t{1} << (cell % 64);
+            if (x > 0) masks->notFirstColumn[cell / 64] |= bit;
+            if (x < width - 1) masks->notLastColumn[cell / 64] |= bit;
+            (y & 1 ? masks->oddRows : masks->evenRows)[cell / 64] |= bit;
+        }
+    }
+    masks_ = masks;
+}
+
+void Bitboard::clear() {
+    std::fill(words_.begin(), words_.end(), 0);
+}
+
+const bool Bitboard::any() const {
+    return std::any_of(words_.begin(), words_.end(), [](std::uint64_t word) { return word != 0; });
+}
+
+Bitboard& Bitboard::operator|=(const Bitboard& other) {
+    for (size_t i = 0; i < words_.size(); i++)
+        words_[i] |= other.words_[i];
+    return *this;
+}
+
+Bitboard& Bitboard::operator&=(const Bitboard& other) {
+    for (size_t i = 0; i < words_.size(); i++)
+        words_[i] &= other.words_[i];
+    return *this;
+}
+
+Bitboard& Bitboard::andNot(const Bitboard& other) {
+    for (size_t i = 0; i < words_.size(); i++)
+        words_[i] &= ~other.words_[i];
+    return *this;
+}
+
+Bitboard::Span Bitboard::getSpan() const {
+    auto first = std::find_if(words_.begin(), words_.end(), [](std::uint64_t word) { return word != 0; });
+    if (first == words_.end()) return Span{};
+
+    auto last = std::find_if(words_.rbegin(), words_.rend(), [](std::uint64_t word) { return word != 0; });
+    return Span{static_cast<size_t>(first - words_.begin()), static_cast<size_t>(words_.rend() - last)};
+}
+
+Bitboard::Span Bitboard::widen(const Span& span) const {
+    // Words reached by the furthest shift (+-(width + 1) bits) around a word
+    size_t reach = static_cast<size_t>(width_ + 1) / 64 + 1;
+    return Span{span.first > reach ? span.first - reach : 0, std::min(words_.size(), span.last + reach)};
+}
+
+void Bitboard::orNeighbors(Bitboard& out, int direction, size_t first, size_t last) const {
+    // Offset of the neighbor bit, and the column it may not come from
+    auto shift = [this](std::pair<int, int> offset) {
+        auto [dx, dy] = offset;
+        const std::vector<std::uint64_t>* column = nullptr;
+        if (dx < 0) column = &masks_->notFirstColumn;
+        else if (dx > 0) column = &masks_->notLastColumn;
+        return std::pair{static_cast<std::int64_t>(dx) + static_cast<std::int64_t>(dy) * width_, column};
+    };
+    auto [oddDelta, oddColumn] = shift(HexagonUtils::neighborOffset(1, direction));
+    auto [evenDelta, evenColumn] = shift(HexagonUtils::neighborOffset(0, direction));
+
+    for (size_t i = first; i < last; i++) {
+        std::int64_t bit = static_cast<std::int64_t>(i) * 64;
+        std::uint64_t oddBits = bitsAt(words_, bit + oddDelta);
+        if (oddColumn) oddBits &= (*oddColumn)[i];
+
+        // Same neighbor on both parities (same row)
+        if (oddDelta == evenDelta) {
+            out.words_[i] |= oddBits;
+            continue;
+        }
+
+        std::uint64_t evenBits = bitsAt(words_, bit + evenDelta);
+        if (evenColumn) evenBits &= (*evenColumn)[i];
+        out.words_[i] |= (oddBits & masks_->oddRows[i]) | (evenBits & masks_->evenRows[i]);
+    }
+}
+
+void Bitboard::dilateInto(Bitboard& out, const Span& span) const {
+    for (size_t i = span.first; i < span.last; i++)
+        out.words_[i] = words_[i];
+    for (int direction = 0; direction < 6; direction++)
+        orNeighbors(out, direction, span.first, span.last);
+}
+
+Bitboard Bitboard::flood(int cell) const {
+    Bitboard region = *this;
+    region.clear();
+    if (!test(cell)) return region;
+    region.set(cell);
+
+    // Words changed by the last step: new cells can only be next to them
+    Span changed{static_cast<size_t>(cell) / 64, static_cast<size_t>(cell) / 64 + 1};
+    Bitboard next = region;
+
+    while (!changed.empty()) {
+        Span span = widen(changed);
+        for (int direction = 0; direction < 6; direction++)
+            region.orNeighbors(next, direction, span.first, span.last);
+
+        // Keep the cells of this board, stop when the region no longer grows
+        changed = Span{words_.size(), 0};
+        for (size_t i = span.first; i < span.last; i++) {
+            next.words_[i] &= words_[i];
+            if (next.words_[i] == region.words_[i]) continue;
+
+            region.words_[i] = next.words_[i];
+            changed.first = std::min(changed.first, i);
+            changed.last = std::max(changed.last, i + 1);
+        }
+    }
+    return region;
+}
@@ -0,0 +1,90 @@
+#include "Rules/MapBitboards.hpp"
+#include "GameElements/GameElement.hpp"
+
+#include <algorithm>
+
+MapBitboards::MapBitboards(int width, int height)
+    : empty_(width, height), playable_(empty_), owners_(1, empty_),
+      strong_(empty_), strongOwned_(empty_), dilated_(empty_), shields_(empty_)
+{}
+
+Bitboard& MapBitboards::owned(int player) {
+    if (player >= static_cast<int>(owners_.size()))
+        owners_.resize(player + 1, empty_);
+    return owners_[player];
+}
+
+void MapBitboards::addPlayable(int cell) {
+    playable_.set(cell);
+    owners_[0].set(cell);
+}
+
+void MapBitboards::setOwner(int cell, int oldPlayer, int player) {
+    owned(oldPlayer).reset(cell);
+    owned(player).set(cell);
+}
+
+void MapBitboards::setElement(int cell, const std::shared_ptr<GameElement>& oldElt, const std::shared_ptr<GameElement>& elt) {
+    if (oldElt && oldElt->getStrength() > 0 && oldElt->getStrength() < static_cast<int>(strengths_.size()))
+        strengths_[oldElt->getStrength()].reset(cell);
+
+    if (elt && elt->getStrength() > 0) {
+        if (elt->getStrength() >= static_cast<int>(strengths_.size()))
+            strengths_.resize(elt->getStrength() + 1, empty_);
+        strengths_[elt->getStrength()].set(cell);
+    }
+}
+
+const Bitboard& MapBitboards::shieldsOn(int strength, const Bitboard::Span& span) const {
+    // Strong elements of the cells and of their neighbors
+    Bitboard::Span near = empty_.widen(span);
+    for (size_t i = near.first; i < near.last; i++) {
+        std::uint64_t strong = strength <= 0 ? playable_.getWords()[i] : 0;
+        for (int s = std::max(strength, 1); s < static_cast<int>(strengths_.size()); s++)
+            strong |= strengths_[s].getWords()[i];
+        strong_.word(i) = strong;
+    }
+    for (size_t i = span.first; i < span.last; i++)
+        shields_.word(i) = strong_.getWords()[i];
+
+    // Strong elements also shield the neighbors of their owner
+    for (size_t player = 1; player < owners_.size(); player++) {
+        const auto& owned = owners_[player].getWords();
+        bool any = false;
+        for (size_t i = near.first; i < near.last; i++) {
+            strongOwned_.word(i) = strong_.getWords()[i] & owned[i];
+            any = any || strongOwned_.getWords()[i] != 0;
+        }
+        if (!any) continue;
+
+        strongOwned_.dilateInto(dilated_, span);
+        for (size_t i = span.first; i < span.last; i++)
+            shields_.word(i) |= dilated_.getWords()[i] & owned[i];
+    }
+    return shields_;
+}
+
+Bitboard MapBitboards::getShields(int strength) const {
+    return shieldsOn(strength, Bitboard::Span{0, empty_.getWords().size()});
+}
+
+Bitboard MapBitboards::getRegion(int cell) const {
+    for (auto& owned : owners_)
+        if (owned.test(cell))
+            return owned.flood(cell);
+    return empty_;
+}
+
+Bitboard MapBitboards::getReachable(const Bitboard& region, int strength) const {
+    Bitboard reachable = region;
+    Bitboard::Span span = region.getSpan();
+    if (strength <= 0 || span.empty()) return reachable;
+
+    // Cells around the region that the troop can take, on the words around it only
+    Bitboard::Span around = region.widen(span);
+    const auto& shields = shieldsOn(strength, around);
+    region.dilateInto(dilated_, around);
+    for (size_t i = around.first; i < around.last; i++)
+        reachable.word(i) |= dilated_.getWords()[i] & playable_.getWords()[i] & ~shields.getWords()[i];
+    return reachable;
+}
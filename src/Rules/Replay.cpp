@@ -0,0 +1,165 @@
+#include "Rules/Replay.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+    constexpr char MAGIC[4] = {'K', 'R', 'P', 'L'};
+    constexpr std::uint8_t VERSION = 1;
+
+    void writeInt(std::string& out, std::uint32_t value, int nbBytes) {
+        for (int i = 0; i < nbBytes; i++)
+            out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+
+    void writePoint(std::string& out, const Point& point) {
+        writeInt(out, static_cast<std::uint32_t>(point.getX()), 2);
+        writeInt(out, static_cast<std::uint32_t>(point.getY()), 2);
+    }
+
+    /// Read little endian integers from the content of a file
+    class Reader {
+    public:
+        explicit Reader(const std::string& data) : data_(data) {}
+
+        std::uint32_t readInt(int nbBytes) {
+            if (pos_ + nbBytes > data_.size())
+                throw std::runtime_error("Replay tronqué.");
+
+            std::uint32_t value = 0;
+            for (int i = 0; i < nbBytes; i++)
+                value |= static_cast<std::uint32_t>(static_cast<unsigned char>(data_[pos_++])) << (8 * i);
+            return value;
+        }
+
+        Point readPoint() {
+            int x = static_cast<int>(readInt(2));
+            int y = static_cast<int>(readInt(2));
+            return Point{x, y};
+        }
+
+        std::string readString(size_t size) {
+            if (pos_ + size > data_.size())
+                throw std::runtime_error("Replay tronqué.");
+
+            std::string str = data_.substr(pos_, size);
+            pos_ += size;
+            return str;
+        }
+
+    private:
+        const std::string& data_;
+        size_t pos_ = 0;
+    };
+}
+
+Replay Replay::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("Impossible d'ouvrir le replay: " + path);
+    std::string data{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+
+    // Header
+    Reader reader{data};
+    if (reader.readString(sizeof(MAGIC)) != std::string(MAGIC, sizeof(MAGIC)))
+        throw std::runtime_error("Fichier de replay invalide: " + path);
+    if (reader.readInt(1) != VERSION)
+        throw std::runtime_error("Version de replay non supportée: " + path);
+
+    unsigned int seed = reader.readInt(4);
+    std::string mapFile = reader.readString(reader.readInt(2));
+    Replay replay{mapFile, seed};
+
+    // Actions
+    std::uint32_t nbActions = reader.readInt(4);
+    replay.actions_.reserve(nbActions);
+    for (std::uint32_t i = 0; i < nbActions; i++) {
+        Action action;
+        action.type = static_cast<Action::Type>(reader.readInt(1));
+
+        switch (action.type) {
+            case Action::Type::Move:
+            case Action::Type::Merge:
+                action.from = reader.readPoint();
+                action.to = reader.readPoint();
+                break;
+            case Action::Type::Buy:
+                action.element = static_cast<char>(reader.readInt(1));
+                action.source = static_cast<Action::Source>(reader.readInt(1));
+                if (action.source != Action::Source::Town && action.source != Action::Source::Shop)
+                    throw std::runtime_error("Origine d'achat inconnue dans le replay: " + path);
+                action.from = reader.readPoint();
+                action.to = reader.readPoint();
+                break;
+            case Action::Type::Castle:
+                action.to = reader.readPoint();
+                action.from = action.to;
+                action.element = 'C';
+                break;
+            case Action::Type::EndTurn:
+            case Action::Type::Undo:
+                break;
+            default:
+                throw std::runtime_error("Action inconnue dans le replay: " + path);
+        }
+
+        replay.actions_.push_back(action);
+    }
+
+    return replay;
+}
+
+Replay::Replay(const std::string& mapFile, unsigned int seed) : mapFile_(mapFile), seed_(seed) {}
+
+void Replay::record(const Action& action) {
+    actions_.push_back(action);
+}
+
+void Replay::save(const std::string& path) const {
+    std::string data(MAGIC, sizeof(MAGIC));
+    writeInt(data, VERSION, 1);
+    writeInt(data, seed_, 4);
+    writeInt(data, static_cast<std::uint32_t>(mapFile_.size()), 2);
+    data += mapFile_;
+
+    writeInt(data, static_cast<std::uint32_t>(actions_.size()), 4);
+    for (auto& action : actions_) {
+        writeInt(data, static_cast<std::uint32_t>(action.type), 1);
+
+        switch (action.type) {
+            case Action::Type::Move:
+            case Action::Type::Merge:
+                writePoint(data, action.from);
+                writePoint(data, action.to);
+                break;
+            case Action::Type::Buy:
+                writeInt(data, static_cast<std::uint32_t>(action.element), 1);
+                writeInt(data, static_cast<std::uint32_t>(action.source), 1);
+                writePoint(data, action.from);
+                writePoint(data, action.to);
+                break;
+            case Action::Type::Castle:
+                writePoint(data, action.to);
+                break;
+            default:
+                break;
+        }
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out || !out.write(data.data(), static_cast<std::streamsize>(data.size())))
+        throw std::runtime_error("Impossible d'écrire le replay: " + path);
+}
+
+const std::string& Replay::getMapFile() const {
+    return mapFile_;
+}
+
+const unsigned int Replay::getSeed() const {
+    return seed_;
+}
+
+const std::vector<Action>& Replay::getActions() const {
+    return actions_;
+}
@@ -0,0 +1,36 @@
+#include "Rules/ReplayPlayer.hpp"
+
+#include <stdexcept>
+#include <string>
+
+ReplayPlayer::ReplayPlayer(const Replay& replay) : replay_(replay) {}
+
+std::unique_ptr<GameMap> ReplayPlayer::createMap(const Point& pos, const Size& size) const {
+    return std::make_unique<GameMap>(pos, size, replay_.getMapFile(), replay_.getSeed());
+}
+
+const bool ReplayPlayer::step(GameMap& map) {
+    if (isFinished()) return false;
+
+    if (!map.applyAction(replay_.getActions()[position_]))
+        throw std::runtime_error("Replay désynchronisé à l'action " + std::to_string(position_));
+
+    position_++;
+    return true;
+}
+
+void ReplayPlayer::playAll(GameMap& map) {
+    while (step(map));
+}
+
+const bool ReplayPlayer::isFinished() const {
+    return position_ >= replay_.getActions().size();
+}
+
+const size_t ReplayPlayer::getPosition() const {
+    return position_;
+}
+
+const Replay& ReplayPlayer::getReplay() const {
+    return replay_;
+}
@@ -0,0 +1,34 @@
+#include "Rules/ZobristHash.hpp"
+#include "GameElements/GameElement.hpp"
+
+namespace {
+    constexpr std::uint64_t SEED = 0x4b6f6e6b72ULL;    // "Konkr"
+
+    /// Feature families, so that keys of different kinds never collide
+    enum Feature : std::uint64_t { OWNER = 1, ELEMENT = 2, SIDE = 3 };
+
+    constexpr std::uint64_t mix(std::uint64_t x) {
+        // splitmix64 finalizer
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    constexpr std::uint64_t key(Feature feature, std::uint64_t cell, std::uint64_t value) {
+        return mix(SEED ^ (cell << 24) ^ (value << 4) ^ feature);
+    }
+}
+
+std::uint64_t ZobristHash::ownerKey(int cell, int player) {
+    return player ? key(OWNER, static_cast<std::uint64_t>(cell), static_cast<std::uint64_t>(player)) : 0;
+}
+
+std::uint64_t ZobristHash::elementKey(int cell, const std::shared_ptr<GameElement>& elt) {
+    char letter = GameElement::getLetter(elt);
+    return letter != '.' ? key(ELEMENT, static_cast<std::uint64_t>(cell), static_cast<unsigned char>(letter)) : 0;
+}
+
+std::uint64_t ZobristHash::sideKey(int player) {
+    return player ? key(SIDE, 0, static_cast<std::uint64_t>(player)) : 0;
+}
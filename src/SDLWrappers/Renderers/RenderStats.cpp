@@ -0,0 +1,11 @@
+#include "SDLWrappers/Renderers/RenderStats.hpp"
+
+unsigned long RenderStats::blits_ = 0;
+unsigned long RenderStats::pixels_ = 0;
+unsigned long RenderStats::targetSwitches_ = 0;
+
+void RenderStats::reset() {
+    blits_ = 0;
+    pixels_ = 0;
+    targetSwitches_ = 0;
+}
@@ -1,10 +1,12 @@
 #include "SDLWrappers/Renderers/RenderTargetGuard.hpp"
+#include "SDLWrappers/Renderers/RenderStats.hpp"
 
 RenderTargetGuard::RenderTargetGuard(const std::weak_ptr<SDL_Renderer>& renderer, const std::shared_ptr<SDL_Texture> newTarget): renderer_(renderer) {
     auto lrenderer = renderer_.lock();
     if (!lrenderer) throw std::runtime_error("Renderer isn't initialized.");
     
     oldTarget_ = SDL_GetRenderTarget(lrenderer.get());
+    if (oldTarget_ != newTarget.get()) RenderStats::countTargetSwitch();
     SDL_SetRenderTarget(lrenderer.get(), newTarget.get());
 }
 
@@ -13,6 +15,7 @@ RenderTargetGuard::RenderTargetGuard(const std::weak_ptr<SDL_Renderer>& renderer
     if (!lrenderer) throw std::runtime_error("Renderer isn't initialized.");
     
     oldTarget_ = SDL_GetRenderTarget(lrenderer.get());
+    if (oldTarget_ != newTarget->get()) RenderStats::countTargetSwitch();
     SDL_Check(SDL_SetRenderTarget(lrenderer.get(), newTarget->get()), "SDL_SetRenderTarget");
 }
 
@@ -20,5 +23,6 @@ RenderTargetGuard::~RenderTargetGuard() {
     auto lrenderer = renderer_.lock();
     if (!lrenderer) return;
 
+    if (SDL_GetRenderTarget(lrenderer.get()) != oldTarget_) RenderStats::countTargetSwitch();
     SDL_Check(SDL_SetRenderTarget(lrenderer.get(), oldTarget_), "SDL_SetRenderTarget");
 }
@@ -2,7 +2,10 @@
 #include "Utils/ColorUtils.hpp"
 #include "SDLWrappers/Coords/Point.hpp"
 #include "SDLWrappers/Renderers/RenderTargetGuard.hpp"
+#include "SDLWrappers/Renderers/RenderStats.hpp"
 #include <sstream>
+#include <algorithm>
+#include <cmath>
 #include "Utils/Checker.hpp"
 
 // Constructeur : charge la texture depuis le fichier
@@ -47,7 +50,9 @@ Texture::Texture(const std::weak_ptr<SDL_Renderer>& renderer, int w, int h): ren
 Texture::Texture(const std::weak_ptr<SDL_Renderer>& renderer, const Size& size): 
     Texture(renderer, size.getWidth(), size.getHeight()) {}
 
-Texture::Texture(Texture&& o): texture_(o.texture_), renderer_(o.renderer_), size_(o.size_) {
+Texture::Texture(Texture&& o)
+    : texture_(o.texture_), renderer_(o.renderer_), size_(o.size_), origin_(o.origin_),
+      scale_(o.scale_), colorMod_(o.colorMod_), mips_(std::move(o.mips_)) {
     o.texture_  = nullptr;
     o.renderer_ = {};
     o.size_     = Size{0, 0};
@@ -62,6 +67,10 @@ Texture& Texture::operator=(Texture&& o) noexcept {
         texture_   = o.texture_;
         renderer_  = o.renderer_;
         size_      = o.size_;
+        origin_    = o.origin_;
+        scale_     = o.scale_;
+        colorMod_  = o.colorMod_;
+        mips_      = std::move(o.mips_);
 
         o.texture_  = nullptr;
         o.renderer_  = {};
@@ -71,7 +80,12 @@ Texture& Texture::operator=(Texture&& o) noexcept {
 }
 
 void Texture::colorize(const SDL_Color& color) {
+    if (color.r == colorMod_.r && color.g == colorMod_.g && color.b == colorMod_.b) return;
+
+    colorMod_ = color;
     SDL_Check(SDL_SetTextureColorMod(texture_.get(), color.r, color.g, color.b), "SDL_SetTextureColorMod");
+    for (auto& mip : mips_)
+        mip->colorize(color);
 }
 
 std::shared_ptr<Texture> Texture::copy() {
@@ -112,20 +126,120 @@ void Texture::fill(const SDL_Color& color) const {
     auto lrenderer = renderer_.lock();
     if (!lrenderer) return;
 
+    mips_.clear();
     RenderTargetGuard target(renderer_, texture_);
     SDL_Check(SDL_SetRenderDrawColor(lrenderer.get(), color.r, color.g, color.b, color.a), "SDL_SetRenderDrawColor");
     SDL_Check(SDL_RenderClear(lrenderer.get()), "SDL_RenderClear");
 }
 
+void Texture::fill(const SDL_Color& color, const Rect& rect) const {
+    auto lrenderer = renderer_.lock();
+    if (!lrenderer) return;
 
-void Texture::blit(const std::weak_ptr<Texture>& src, const SDL_Rect* srcRect, const SDL_Rect* destRect) const {
+    mips_.clear();
+    RenderTargetGuard target(renderer_, texture_);
+    SDL_Check(SDL_SetRenderDrawColor(lrenderer.get(), color.r, color.g, color.b, color.a), "SDL_SetRenderDrawColor");
+    SDL_Check(SDL_SetRenderDrawBlendMode(lrenderer.get(), SDL_BLENDMODE_NONE), "SDL_SetRenderDrawBlendMode");
+    SDL_Rect local;
+    SDL_Check(SDL_RenderFillRect(lrenderer.get(), toLocal(&rect.get(), local)), "SDL_RenderFillRect");
+    SDL_SetRenderDrawBlendMode(lrenderer.get(), SDL_BLENDMODE_BLEND);
+}
+
+
+void Texture::setOrigin(const Point& origin) {
+    origin_ = origin;
+}
+
+const Point& Texture::getOrigin() const {
+    return origin_;
+}
+
+void Texture::setScale(double scale) {
+    scale_ = scale;
+}
+
+const double Texture::getScale() const {
+    return scale_;
+}
+
+Texture& Texture::getMip(int level) {
+    level = std::min(level, MAX_MIP_LEVEL);
+    while (static_cast<int>(mips_.size()) < level) {
+        Texture& prev = mips_.empty() ? *this : *mips_.back();
+        if (prev.getWidth() < 2 || prev.getHeight() < 2) break;
+
+        auto lrenderer = renderer_.lock();
+        if (!lrenderer) break;
+
+        // Half of the previous level, averaged by the linear filter (pixels copied without blending or color)
+        auto mip = std::make_shared<Texture>(renderer_, prev.getWidth() / 2, prev.getHeight() / 2);
+        SDL_Check(SDL_SetTextureScaleMode(prev.get(), SDL_ScaleModeLinear), "SDL_SetTextureScaleMode");
+        SDL_Check(SDL_SetTextureColorMod(prev.get(), 255, 255, 255), "SDL_SetTextureColorMod");
+        prev.removeAlpha();
+        {
+            RenderTargetGuard target(renderer_, mip->texture_);
+            RenderStats::countBlit(nullptr, mip->getSize());
+            SDL_Check(SDL_RenderCopy(lrenderer.get(), prev.get(), nullptr, nullptr), "SDL_RenderCopy");
+        }
+        prev.convertAlpha();
+        SDL_Check(SDL_SetTextureColorMod(prev.get(), colorMod_.r, colorMod_.g, colorMod_.b), "SDL_SetTextureColorMod");
+        SDL_Check(SDL_SetTextureScaleMode(prev.get(), SDL_ScaleModeNearest), "SDL_SetTextureScaleMode");
+
+        mip->colorize(colorMod_);
+        mips_.push_back(mip);
+    }
+    return mips_.empty() || level == 0 ? *this : *mips_[std::min(level, static_cast<int>(mips_.size())) - 1];
+}
+
+const SDL_Rect* Texture::toLocal(const SDL_Rect* destRect, SDL_Rect& local) const {
+    if (!destRect || (origin_.getX() == 0 && origin_.getY() == 0 && scale_ == 1)) return destRect;
+
+    // Edges scaled one by one, so that adjacent rectangles stay adjacent
+    int x1 = static_cast<int>(std::lround((destRect->x - origin_.getX()) * scale_));
+    int y1 = static_cast<int>(std::lround((destRect->y - origin_.getY()) * scale_));
+    int x2 = static_cast<int>(std::lround((destRect->x + destRect->w - origin_.getX()) * scale_));
+    int y2 = static_cast<int>(std::lround((destRect->y + destRect->h - origin_.getY()) * scale_));
+    local = SDL_Rect{x1, y1, x2 - x1, y2 - y1};
+    return &local;
+}
+
+void Texture::render(Texture& src, const SDL_Rect* srcRect, const SDL_Rect* destRect) const {
     auto lrenderer = renderer_.lock();
-    auto lsrc = src.lock();
-    if (!lrenderer || !lsrc) return;
+    if (!lrenderer) return;
+
+    // Pre-scaled variant of the source (its part is scaled the same way)
+    int level = 0;
+    while (level < MAX_MIP_LEVEL && scale_ * (2 << level) <= 1.0) level++;
+    Texture& from = level ? src.getMip(level) : src;
+
+    SDL_Rect srcLocal;
+    if (&from != &src && srcRect) {
+        double sx = static_cast<double>(from.getWidth()) / src.getWidth();
+        double sy = static_cast<double>(from.getHeight()) / src.getHeight();
+        int x1 = static_cast<int>(std::lround(srcRect->x * sx));
+        int y1 = static_cast<int>(std::lround(srcRect->y * sy));
+        srcLocal = SDL_Rect{
+            x1, y1,
+            static_cast<int>(std::lround((srcRect->x + srcRect->w) * sx)) - x1,
+            static_cast<int>(std::lround((srcRect->y + srcRect->h) * sy)) - y1
+        };
+        srcRect = &srcLocal;
+    }
+
+    // Drawn onto: the variants of this texture are out of date
+    mips_.clear();
 
-    lsrc->convertAlpha();
+    from.convertAlpha();
     RenderTargetGuard target(renderer_, texture_);
-    SDL_Check(SDL_RenderCopy(lrenderer.get(), lsrc->get(), srcRect, destRect), "SDL_RenderCopy");
+    SDL_Rect local;
+    const SDL_Rect* dest = toLocal(destRect, local);
+    RenderStats::countBlit(dest, size_);
+    SDL_Check(SDL_RenderCopy(lrenderer.get(), from.get(), srcRect, dest), "SDL_RenderCopy");
+}
+
+void Texture::blit(const std::weak_ptr<Texture>& src, const SDL_Rect* srcRect, const SDL_Rect* destRect) const {
+    if (auto lsrc = src.lock())
+        render(*lsrc, srcRect, destRect);
 }
 
 void Texture::blit(const std::weak_ptr<Texture>& src) const {
@@ -150,7 +264,7 @@ void Texture::blit(const std::weak_ptr<Texture>& src, const Rect& destRect) cons
 
 void Texture::blit(const std::weak_ptr<Texture>& src, const Rect& srcRect, const Point& destPos) const {
     if (auto lsrc = src.lock()) {
-        Rect destRect(destPos, lsrc->getSize());
+        Rect destRect(destPos, srcRect.getSize());
         blit(src, &srcRect.get(), &destRect.get());
     }
 }
@@ -166,12 +280,7 @@ void Texture::blit(const std::weak_ptr<Texture>& src, const Rect& srcRect, const
 
 
 void Texture::blit(const std::unique_ptr<Texture>& src, const SDL_Rect* srcRect, const SDL_Rect* destRect) const {
-    auto lrenderer = renderer_.lock();
-    if (!lrenderer) return;
-
-    src->convertAlpha();
-    RenderTargetGuard target(renderer_, texture_);
-    SDL_Check(SDL_RenderCopy(lrenderer.get(), src->get(), srcRect, destRect), "SDL_RenderCopy");
+    if (src) render(*src, srcRect, destRect);
 }
 
 
@@ -180,5 +289,6 @@ void Texture::display(const Point& destPos) const {
     if (!lrenderer) return;
 
     SDL_Rect destRect{destPos.getX(), destPos.getY(), getWidth(), getHeight()};
+    RenderStats::countBlit(&destRect, size_);
     SDL_Check(SDL_RenderCopy(lrenderer.get(), texture_.get(), nullptr, &destRect), "SDL_RenderCopy");
 }
@@ -0,0 +1,123 @@
+#include "SDLWrappers/Renderers/TileCache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+TileCache::TileCache(const std::weak_ptr<SDL_Renderer>& renderer, const Size& surfaceSize, size_t capacity)
+    : renderer_(renderer),
+      surfaceSize_(surfaceSize),
+      cols_((surfaceSize.getWidth() + TILE_SIZE - 1) / TILE_SIZE),
+      rows_((surfaceSize.getHeight() + TILE_SIZE - 1) / TILE_SIZE),
+      capacity_(capacity)
+{
+    if (capacity_ == 0)
+        throw std::runtime_error("Le cache de tuiles doit contenir au moins une tuile.");
+}
+
+const Size& TileCache::getSurfaceSize() const {
+    return surfaceSize_;
+}
+
+void TileCache::setLevel(int level) {
+    level = std::clamp(level, 0, MAX_LEVEL);
+    if (level == level_) return;
+
+    // Other tiles: the textures are kept but every tile is drawn again
+    level_ = level;
+    span_ = TILE_SIZE << level_;
+    cols_ = (surfaceSize_.getWidth() + span_ - 1) / span_;
+    rows_ = (surfaceSize_.getHeight() + span_ - 1) / span_;
+
+    std::vector<std::shared_ptr<Texture>> textures;
+    for (auto& [index, tile] : tiles_)
+        textures.push_back(std::move(tile.texture));
+    tiles_.clear();
+    lru_.clear();
+    lruPos_.clear();
+    freeTextures_ = std::move(textures);
+}
+
+const int TileCache::getLevel() const {
+    return level_;
+}
+
+Rect TileCache::getTilesIn(const Rect& area) const {
+    int x1 = std::max(0, area.getX() / span_);
+    int y1 = std::max(0, area.getY() / span_);
+    int x2 = std::min(cols_, (area.getX() + area.getWidth() + span_ - 1) / span_);
+    int y2 = std::min(rows_, (area.getY() + area.getHeight() + span_ - 1) / span_);
+    if (area.getWidth() <= 0 || area.getHeight() <= 0 || x2 <= x1 || y2 <= y1)
+        return Rect{0, 0, 0, 0};
+    return Rect{x1, y1, x2 - x1, y2 - y1};
+}
+
+TileCache::Tile& TileCache::acquire(int tx, int ty) {
+    int index = ty * cols_ + tx;
+
+    // Already cached: most recently used
+    auto it = tiles_.find(index);
+    if (it != tiles_.end()) {
+        lru_.splice(lru_.begin(), lru_, lruPos_[index]);
+        return it->second;
+    }
+
+    // Full: take the texture of the least recently used tile
+    std::shared_ptr<Texture> texture;
+    if (tiles_.size() >= capacity_) {
+        int evicted = lru_.back();
+        texture = std::move(tiles_[evicted].texture);
+        tiles_.erase(evicted);
+        lruPos_.erase(evicted);
+        lru_.pop_back();
+    }
+    else if (!freeTextures_.empty()) {
+        texture = std::move(freeTextures_.back());
+        freeTextures_.pop_back();
+    }
+    else texture = std::make_shared<Texture>(renderer_, Size{TILE_SIZE, TILE_SIZE});
+
+    // New tile, to draw
+    Tile tile;
+    tile.rect = Rect{
+        tx * span_,
+        ty * span_,
+        std::min(span_, surfaceSize_.getWidth() - tx * span_),
+        std::min(span_, surfaceSize_.getHeight() - ty * span_)
+    };
+    double scale = 1.0 / (1 << level_);
+    tile.source = Rect{
+        0, 0,
+        static_cast<int>(std::lround(tile.rect.getWidth() * scale)),
+        static_cast<int>(std::lround(tile.rect.getHeight() * scale))
+    };
+    tile.texture = std::move(texture);
+    tile.texture->setOrigin(tile.rect.getPos());
+    tile.texture->setScale(scale);
+
+    lru_.push_front(index);
+    lruPos_[index] = lru_.begin();
+    return tiles_[index] = std::move(tile);
+}
+
+std::vector<Rect> TileCache::getAreas() const {
+    std::vector<Rect> areas;
+    areas.reserve(tiles_.size());
+    for (auto& [index, tile] : tiles_)
+        areas.push_back(tile.rect);
+    return areas;
+}
+
+void TileCache::invalidate() {
+    for (auto& [index, tile] : tiles_)
+        tile.dirty = true;
+}
+
+void TileCache::invalidate(const Rect& area) {
+    Rect tiles = getTilesIn(area);
+    for (int ty = tiles.getY(); ty < tiles.getY() + tiles.getHeight(); ty++)
+        for (int tx = tiles.getX(); tx < tiles.getX() + tiles.getWidth(); tx++) {
+            auto it = tiles_.find(ty * cols_ + tx);
+            if (it != tiles_.end()) it->second.dirty = true;
+        }
+}
@@ -2,6 +2,7 @@
 #include "SDL.h"
 #include "SDL2/SDL_ttf.h"
 #include "SDLWrappers/Renderers/RenderTargetGuard.hpp"
+#include "SDLWrappers/Renderers/RenderStats.hpp"
 #include "Utils/Checker.hpp"
 
 #include <stdexcept>
@@ -45,6 +46,27 @@ Window::Window(const char* title, const Size& size) {
     }
 }
 
+Window::Window(const Size& size) : size_(size) {
+    // Init SDL without video: nothing is shown
+    SDL_Check(SDL_Init(0), "SDL_Init");
+
+    // Init SDL_ttf
+    if (TTF_Init() < 0)
+        throw std::runtime_error(TTF_GetError());
+
+    // Init surface and its software renderer
+    surface_.reset(SDL_CreateRGBSurfaceWithFormat(0, size.getWidth(), size.getHeight(), 32, SDL_PIXELFORMAT_ARGB8888));
+    if (surface_)
+        renderer_.reset(SDL_CreateSoftwareRenderer(surface_.get()), SDL_DestroyRenderer);
+
+    if (!renderer_) {
+        surface_.reset();
+        TTF_Quit();
+        SDL_Quit();
+        throw std::runtime_error(std::string("SDL_CreateSoftwareRenderer failed: ") + SDL_GetError());
+    }
+}
+
 Window::~Window() {
     TTF_Quit();
     SDL_Quit();
@@ -70,6 +92,7 @@ void Window::blit(const std::weak_ptr<Texture>& src, const SDL_Rect* srcRect, co
 
     lsrc->convertAlpha();
     RenderTargetGuard target(renderer_, std::shared_ptr<SDL_Texture>());
+    RenderStats::countBlit(destRect, size_);
     SDL_Check(SDL_RenderCopy(renderer_.get(), lsrc->get(), srcRect, destRect), "SDL_RenderCopy");
 }
 
@@ -95,7 +118,7 @@ void Window::blit(const std::weak_ptr<Texture>& src, const Rect& destRect) const
 
 void Window::blit(const std::weak_ptr<Texture>& src, const Rect& srcRect, const Point& destPos) const {
     if (auto lsrc = src.lock()) {
-        Rect destRect(destPos, lsrc->getSize());
+        Rect destRect(destPos, srcRect.getSize());
         blit(src, &srcRect.get(), &destRect.get());
     }
 }
@@ -113,6 +136,7 @@ void Window::blit(const std::weak_ptr<Texture>& src, const Rect& srcRect, const
 void Window::blit(const std::unique_ptr<Texture>& src, const SDL_Rect* srcRect, const SDL_Rect* destRect) const {
     src->convertAlpha();
     RenderTargetGuard target(renderer_, std::shared_ptr<SDL_Texture>());
+    RenderStats::countBlit(destRect, size_);
     SDL_Check(SDL_RenderCopy(renderer_.get(), src->get(), srcRect, destRect), "SDL_RenderCopy");
 }
 
@@ -0,0 +1,149 @@
+#include "Utils/HexagonUtils.hpp"
+
+#include <cstddef>
+#include <tuple>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HEXAGON_UTILS_SSE2
+#endif
+
+namespace HexagonUtils {
+
+#ifdef HEXAGON_UTILS_SSE2
+const char* const BATCH_ISA = "SSE2";
+
+namespace {
+    /// Two ints to two doubles
+    inline __m128d load2(const int* values) {
+        return _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(values)));
+    }
+
+    /// Two doubles truncated to two ints, as static_cast<int>
+    inline void store2(int* values, __m128d v) {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(values), _mm_cvttpd_epi32(v));
+    }
+
+    /// Rounding of std::round (halves away from zero), for values in the int range
+    inline __m128d round2(__m128d v) {
+        const __m128d one = _mm_set1_pd(1.0);
+        __m128d t = _mm_cvtepi32_pd(_mm_cvttpd_epi32(v));
+        __m128d f = _mm_sub_pd(v, t);
+        __m128d up = _mm_and_pd(_mm_cmpge_pd(f, _mm_set1_pd(0.5)), one);
+        __m128d down = _mm_and_pd(_mm_cmple_pd(f, _mm_set1_pd(-0.5)), one);
+        return _mm_sub_pd(_mm_add_pd(t, up), down);
+    }
+
+    inline __m128d abs2(__m128d v) {
+        return _mm_andnot_pd(_mm_set1_pd(-0.0), v);
+    }
+
+    inline __m128d neg2(__m128d v) {
+        return _mm_xor_pd(_mm_set1_pd(-0.0), v);
+    }
+
+    /// Select a where mask is set, b elsewhere
+    inline __m128d select2(__m128d mask, __m128d a, __m128d b) {
+        return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+    }
+
+    /// Same operations as the scalar axialToPixel()
+    inline void axialToPixel2(__m128d q, __m128d r, __m128d kx, __m128d ky, int* x, int* y) {
+        store2(x, _mm_mul_pd(kx, _mm_add_pd(q, _mm_div_pd(r, _mm_set1_pd(2.0)))));
+        store2(y, _mm_mul_pd(ky, r));
+    }
+}
+
+void axialToPixel(std::span<const int> qs, std::span<const int> rs, double hexSize,
+                  std::span<int> xs, std::span<int> ys) {
+    const __m128d kx = _mm_set1_pd(hexSize * SQRT3);
+    const __m128d ky = _mm_set1_pd(hexSize * (3.0 / 2.0));
+
+    size_t i = 0;
+    for (; i + 2 <= qs.size(); i += 2)
+        axialToPixel2(load2(&qs[i]), load2(&rs[i]), kx, ky, &xs[i], &ys[i]);
+
+    for (; i < qs.size(); i++)
+        std::tie(xs[i], ys[i]) = axialToPixel(qs[i], rs[i], hexSize);
+}
+
+void offsetToPixel(std::span<const int> cols, std::span<const int> rows, double hexSize,
+                   std::span<int> xs, std::span<int> ys) {
+    const __m128d kx = _mm_set1_pd(hexSize * SQRT3);
+    const __m128d ky = _mm_set1_pd(hexSize * (3.0 / 2.0));
+
+    size_t i = 0;
+    for (; i + 4 <= cols.size(); i += 4) {
+        // offsetToAxial() on four cells: (y - (y & 1)) is even, so / 2 is a shift
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&cols[i]));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&rows[i]));
+        __m128i even = _mm_sub_epi32(y, _mm_and_si128(y, _mm_set1_epi32(1)));
+        __m128i q = _mm_sub_epi32(x, _mm_srai_epi32(even, 1));
+
+        axialToPixel2(_mm_cvtepi32_pd(q), _mm_cvtepi32_pd(y), kx, ky, &xs[i], &ys[i]);
+        axialToPixel2(_mm_cvtepi32_pd(_mm_srli_si128(q, 8)), _mm_cvtepi32_pd(_mm_srli_si128(y, 8)), kx, ky, &xs[i + 2], &ys[i + 2]);
+    }
+
+    for (; i < cols.size(); i++)
+        std::tie(xs[i], ys[i]) = offsetToPixel(cols[i], rows[i], hexSize);
+}
+
+void pixelToAxial(std::span<const int> xs, std::span<const int> ys, double hexSize,
+                  std::span<int> qs, std::span<int> rs) {
+    const __m128d size = _mm_set1_pd(hexSize);
+    const __m128d kqx = _mm_set1_pd(SQRT3 / 3.0);
+    const __m128d kqy = _mm_set1_pd(1.0 / 3.0);
+    const __m128d kr = _mm_set1_pd(2.0 / 3.0);
+
+    size_t i = 0;
+    for (; i + 2 <= xs.size(); i += 2) {
+        __m128d x = load2(&xs[i]);
+        __m128d y = load2(&ys[i]);
+        __m128d q = _mm_div_pd(_mm_sub_pd(_mm_mul_pd(kqx, x), _mm_mul_pd(kqy, y)), size);
+        __m128d r = _mm_div_pd(_mm_mul_pd(kr, y), size);
+
+        // hexRound()
+        __m128d s = _mm_sub_pd(neg2(q), r);
+        __m128d qRound = round2(q);
+        __m128d rRound = round2(r);
+        __m128d sRound = round2(s);
+        __m128d qDiff = abs2(_mm_sub_pd(qRound, q));
+        __m128d rDiff = abs2(_mm_sub_pd(rRound, r));
+        __m128d sDiff = abs2(_mm_sub_pd(sRound, s));
+
+        __m128d fixQ = _mm_and_pd(_mm_cmpgt_pd(qDiff, rDiff), _mm_cmpgt_pd(qDiff, sDiff));
+        __m128d fixR = _mm_andnot_pd(fixQ, _mm_cmpgt_pd(rDiff, sDiff));
+        __m128d newQ = select2(fixQ, _mm_sub_pd(neg2(rRound), sRound), qRound);
+        __m128d newR = select2(fixR, _mm_sub_pd(neg2(qRound), sRound), rRound);
+
+        store2(&qs[i], newQ);
+        store2(&rs[i], newR);
+    }
+
+    for (; i < xs.size(); i++)
+        std::tie(qs[i], rs[i]) = pixelToAxial(xs[i], ys[i], hexSize);
+}
+
+#else
+const char* const BATCH_ISA = "scalar";
+
+void axialToPixel(std::span<const int> qs, std::span<const int> rs, double hexSize,
+                  std::span<int> xs, std::span<int> ys) {
+    for (size_t i = 0; i < qs.size(); i++)
+        std::tie(xs[i], ys[i]) = axialToPixel(qs[i], rs[i], hexSize);
+}
+
+void offsetToPixel(std::span<const int> cols, std::span<const int> rows, double hexSize,
+                   std::span<int> xs, std::span<int> ys) {
+    for (size_t i = 0; i < cols.size(); i++)
+        std::tie(xs[i], ys[i]) = offsetToPixel(cols[i], rows[i], hexSize);
+}
+
+void pixelToAxial(std::span<const int> xs, std::span<const int> ys, double hexSize,
+                  std::span<int> qs, std::span<int> rs) {
+    for (size_t i = 0; i < xs.size(); i++)
+        std::tie(qs[i], rs[i]) = pixelToAxial(xs[i], ys[i], hexSize);
+}
+#endif
+
+}
@@ -0,0 +1,70 @@
+#include "Utils/WorkerPool.hpp"
+
+#include <algorithm>
+
+WorkerPool::WorkerPool(int nbWorkers) {
+    for (int worker = 1; worker < std::max(1, nbWorkers); worker++)
+        threads_.emplace_back(&WorkerPool::work, this, worker);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard lock{mutex_};
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_)
+        thread.join();
+}
+
+const int WorkerPool::getSize() const {
+    return static_cast<int>(threads_.size()) + 1;
+}
+
+void WorkerPool::run(int nbJobs, const Job& job) {
+    // Nothing to share
+    if (threads_.empty() || nbJobs <= 1) {
+        for (int i = 0; i < nbJobs; i++)
+            job(i, 0);
+        return;
+    }
+
+    // Start the batch, take part in it and wait for the threads
+    {
+        std::lock_guard lock{mutex_};
+        job_ = &job;
+        nbJobs_ = nbJobs;
+        nextJob_ = 0;
+        running_ = static_cast<int>(threads_.size());
+        batch_++;
+    }
+    wake_.notify_all();
+    runJobs(0);
+
+    std::unique_lock lock{mutex_};
+    done_.wait(lock, [this]() { return running_ == 0; });
+    job_ = nullptr;
+}
+
+void WorkerPool::work(int worker) {
+    std::uint64_t batch = 0;
+    while (true) {
+        {
+            std::unique_lock lock{mutex_};
+            wake_.wait(lock, [this, batch]() { return stopping_ || batch_ != batch; });
+            if (stopping_) return;
+            batch = batch_;
+        }
+
+        runJobs(worker);
+
+        std::lock_guard lock{mutex_};
+        if (--running_ == 0)
+            done_.notify_one();
+    }
+}
+
+void WorkerPool::runJobs(int worker) {
+    for (int i = nextJob_++; i < nbJobs_; i = nextJob_++)
+        (*job_)(i, worker);
+}
@@ -22,8 +22,11 @@
 #include "Displayers/TreasuryDisplayer.hpp"
 #include "SDLWrappers/Cursor.hpp"
 #include "Utils/Checker.hpp"
+#include "Profiling/ProfileScope.hpp"
+#include "MapGen/BinaryMap.hpp"
 
 #include <stdexcept>
+#include <algorithm>
 #include <ranges>
 #include <random>
 #include <cmath>
@@ -34,19 +37,44 @@
 #include <sstream>
 #include <cctype>
 
-std::mt19937 GameMap::gen_{};
+namespace {
+    /// Purchasable troop: letter, cost and strength
+    struct ShopTroop {
+        char letter;
+        int cost;
+        int strength;
+    };
+
+    /// Troops of the Overlay shop, priced by their own classes
+    const std::vector<ShopTroop>& getShopTroops() {
+        static const std::vector<ShopTroop> shopTroops = [] {
+            std::vector<ShopTroop> troops;
+            for (char letter : {'V', 'P', 'K', 'H'}) {
+                auto troop = GameMap::createGameElement(letter, Point{0, 0});
+                troops.push_back(ShopTroop{letter, troop->getCost(), troop->getStrength()});
+            }
+            return troops;
+        }();
+        return shopTroops;
+    }
+
+    /// Nearest town of a cell as near to several towns of its region (see updateAllIncomes())
+    constexpr int TIED_TOWNS = -2;
+
+    /// Smaller maps update their incomes without threads (posting the regions costs more)
+    constexpr int REGION_THREADS_MIN_CELLS = 1024;
+}
 
-void GameMap::init() {
-    // Create random seed
-    gen_ = std::mt19937{ std::random_device{}() };
+unsigned int GameMap::randomSeed() {
+    return std::random_device{}();
 }
 
-GameMap::GameMap(const Point& pos, const Size size, const std::string mapFile)
-  : GameMap(pos, size, getSizeOfMapFile(mapFile), mapFile)
+GameMap::GameMap(const Point& pos, const Size size, const std::string mapFile, unsigned int seed)
+  : GameMap(pos, size, getSizeOfMapFile(mapFile), mapFile, seed)
 {}
 
-GameMap::GameMap(const Point& pos, const Size size, const std::pair<int, int>& gridSize, const std::string mapFile)
-    : Displayer(pos, size), HexagonGrid<std::shared_ptr<Cell>>(gridSize, nullptr)
+GameMap::GameMap(const Point& pos, const Size size, const std::pair<int, int>& gridSize, const std::string mapFile, unsigned int seed)
+    : Displayer(pos, size), HexagonGrid<std::shared_ptr<Cell>>(gridSize, nullptr), seed_(seed), gen_(seed), replay_(mapFile, seed)
 {
     if (getWidth() < 2 || getHeight() < 2)
         throw std::runtime_error("Une map doit au moins être de taille 2x2.");
@@ -58,6 +86,9 @@ GameMap::GameMap(const Point& pos, const Size size, const std::pair<int, int>& g
 
 
 std::pair<int,int> GameMap::getSizeOfMapFile(const std::string& mapFile) {
+    if (BinaryMap::isBinary(mapFile))
+        return BinaryMap::readSize(mapFile);
+
     std::ifstream in(mapFile);
     if (!in) throw std::runtime_error("Impossible d'ouvrir le fichier de map: " + mapFile);
 
@@ -110,69 +141,109 @@ std::shared_ptr<GameElement> GameMap::createGameElement(char letter, Point pos)
     throw std::runtime_error(std::string("Caractère inattendu: ") + letter);
 }
 
-void GameMap::loadMap(const std::string& mapFile) {
-    std::ifstream in(mapFile);
-    if (!in) throw std::runtime_error("Impossible d'ouvrir le fichier de map.");
-
-    // Get utils dimensions
+std::vector<Point> GameMap::getCellPositions(std::span<const int> xs, std::span<const int> ys) const {
     double islandInnerRadius = Ground::getInnerRadius();
     double islandRadius = Ground::getRadius();
-    std::map<int, std::shared_ptr<Player>> players;
 
-    // Read file
-    int y;
-    std::string line;
-    for (y = 0; y < getHeight() && std::getline(in, line); y++) {
-        if (line.empty()) continue;
-
-        int x;
-        std::string token;
-        std::istringstream iss(line);
-        for (x = 0; x < getWidth() && iss >> token; x++) {
-            if (token.size() != 2) throw std::runtime_error("Malformation du fichier.");
-
-            // Calculate pos of cell
-            auto [posX, posY] = HexagonUtils::offsetToPixel(x, y, islandRadius);
-            Point pos{static_cast<int>(posX + islandInnerRadius), static_cast<int>(posY + islandRadius)};
-
-            // Check Cell char
-            char cellType = token[0];
-            std::shared_ptr<Cell> cell = GameMap::createCell(cellType, pos);
-
-            // if player cell: create and link owner
-            if (std::isdigit(cellType) && cellType != '0') {
-                int playerId = cellType - '0';
-                if (players.find(playerId) == players.end())
-                    players[playerId] = std::make_shared<Player>(ColorUtils::getGroundColor(playerId));
-                PlayableGround::cast(cell)->setOwner(players[playerId]);
-            }
-            set(x, y, cell);
+    std::vector<int> posX(xs.size()), posY(xs.size());
+    HexagonUtils::offsetToPixel(xs, ys, islandRadius, posX, posY);
 
+    std::vector<Point> positions;
+    positions.reserve(xs.size());
+    for (size_t i = 0; i < xs.size(); i++)
+        positions.emplace_back(static_cast<int>(posX[i] + islandInnerRadius), static_cast<int>(posY[i] + islandRadius));
+    return positions;
+}
 
-            // Don't check if it isn't PlayableGround
-            auto pg = PlayableGround::cast(cell);
-            if (!pg) continue;
+void GameMap::loadCell(int x, int y, const Point& pos, char cellType, char eltType, std::map<int, std::shared_ptr<Player>>& players) {
+    // Check Cell char
+    std::shared_ptr<Cell> cell = GameMap::createCell(cellType, pos);
+
+    // if player cell: create and link owner
+    if (std::isdigit(cellType) && cellType != '0') {
+        int playerId = cellType - '0';
+        if (players.find(playerId) == players.end()) {
+            players[playerId] = std::make_shared<Player>(ColorUtils::getGroundColor(playerId));
+            players[playerId]->setNum(playerId);
+        }
+        PlayableGround::cast(cell)->setOwner(players[playerId]);
+    }
+    set(x, y, cell);
+
+
+    // Don't check if it isn't PlayableGround
+    auto pg = PlayableGround::cast(cell);
+    if (!pg) return;
 
 
-            // Check GameElement char
-            char gameEltType = token[1];
-            std::shared_ptr<GameElement> gameElt = createGameElement(gameEltType, pos);
+    // Check GameElement char
+    std::shared_ptr<GameElement> gameElt = createGameElement(eltType, pos);
 
-            // Set element on cell
-            if (std::islower(cellType)) pg->setElement(std::make_shared<Camp>(pos, cellType - 'a' + 1));
-            else if (gameEltType != '.' && (cellType != '0' || gameEltType == 'B' || gameEltType == 'A')) {
-                pg->setElement(gameElt);
-                if (std::islower(gameEltType) || gameEltType == 'T')
-                    pg->getOwner()->addTownCell(pg);
+    // Set element on cell
+    if (std::islower(cellType)) pg->setElement(std::make_shared<Camp>(pos, cellType - 'a' + 1));
+    else if (eltType != '.' && (cellType != '0' || eltType == 'B' || eltType == 'A')) {
+        pg->setElement(gameElt);
+    }
+}
+
+void GameMap::loadBinaryMap(const std::string& mapFile, std::map<int, std::shared_ptr<Player>>& players) {
+    BinaryMap map = BinaryMap::load(mapFile);
+    if (map.width != getWidth() || map.height != getHeight())
+        throw std::runtime_error("Taille de la map binaire inattendue: " + mapFile);
+
+    // Positions of every cell at once
+    std::vector<int> xs, ys;
+    xs.reserve(static_cast<size_t>(getWidth()) * getHeight());
+    ys.reserve(xs.capacity());
+    for (int y = 0; y < getHeight(); y++)
+        for (int x = 0; x < getWidth(); x++) {
+            xs.push_back(x);
+            ys.push_back(y);
+        }
+    std::vector<Point> positions = getCellPositions(xs, ys);
+
+    // Cells are stored row after row, two letters each
+    for (size_t i = 0; i < positions.size(); i++)
+        loadCell(xs[i], ys[i], positions[i], map.cells[2 * i], map.cells[2 * i + 1], players);
+}
+
+void GameMap::loadMap(const std::string& mapFile) {
+    std::map<int, std::shared_ptr<Player>> players;
+
+    if (BinaryMap::isBinary(mapFile)) {
+        loadBinaryMap(mapFile, players);
+    } else {
+        std::ifstream in(mapFile);
+        if (!in) throw std::runtime_error("Impossible d'ouvrir le fichier de map.");
+
+        // Positions of the cells of a row (the same columns for every row)
+        std::vector<int> xs(getWidth()), ys(getWidth());
+        for (int x = 0; x < getWidth(); x++) xs[x] = x;
+
+        // Read file
+        int y;
+        std::string line;
+        for (y = 0; y < getHeight() && std::getline(in, line); y++) {
+            if (line.empty()) continue;
+
+            std::fill(ys.begin(), ys.end(), y);
+            std::vector<Point> positions = getCellPositions(xs, ys);
+
+            int x;
+            std::string token;
+            std::istringstream iss(line);
+            for (x = 0; x < getWidth() && iss >> token; x++) {
+                if (token.size() != 2) throw std::runtime_error("Malformation du fichier.");
+                loadCell(x, y, positions[x], token[0], token[1], players);
             }
+
+            for (; x < getWidth(); x++)
+                set(x, y, std::make_shared<Water>());
         }
-        
-        for (; x < getWidth(); x++)
-            set(x, y, std::make_shared<Water>());
-    }
 
-    if (y != getHeight())
-        throw std::runtime_error("Le fichier de map n'a pas assez de lignes (attendu " + std::to_string(getHeight()) + ")");
+        if (y != getHeight())
+            throw std::runtime_error("Le fichier de map n'a pas assez de lignes (attendu " + std::to_string(getHeight()) + ")");
+    }
 
     // Move players
     players_.reserve(players.size());
@@ -210,17 +281,8 @@ void GameMap::saveMap() const {
 
             // GameElements
             char eltChar = '.';
-            if (auto pg = PlayableGround::cast(cell)) {
-                auto elt = pg->getElement();
-                if (Town::is(elt))          eltChar = 'T';
-                else if (Castle::is(elt))   eltChar = 'C';
-                else if (Camp::is(elt))     eltChar = 'A';
-                else if (Villager::is(elt)) eltChar = 'V';
-                else if (Pikeman::is(elt))  eltChar = 'P';
-                else if (Knight::is(elt))   eltChar = 'K';
-                else if (Hero::is(elt))     eltChar = 'H';
-                else if (Bandit::is(elt))   eltChar = 'B';
-            }
+            if (auto pg = PlayableGround::cast(cell))
+                eltChar = GameElement::getLetter(pg->getElement());
 
             // Write tokens
             out << cellChar << eltChar;
@@ -270,38 +332,46 @@ void GameMap::setPos(const Point& pos) {
 
 
 void GameMap::updateNeighbors() {
+    invalidate();
     auto w = getWidth();
     auto h = getHeight();
 
+    // New hash: cells replaced since the last call must not update it anymore
+    hash_ = std::make_shared<ZobristHash>();
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+            if (auto pg = PlayableGround::cast(get(x, y)))
+                pg->attachHash(hash_, y * w + x);
+
+    // New bitboards, for the same reason
+    bitboards_ = std::make_shared<MapBitboards>(w, h);
+    reachableRegions_.clear();
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+            if (auto pg = PlayableGround::cast(get(x, y)))
+                pg->attachBitboards(bitboards_);
+
+    // Neighbors of the cells, in the order of the offsets of odd and even rows
+    std::vector<std::weak_ptr<Cell>> neighbors(6);
     for (int y = 0; y < h; y++) {
-        // Odd cell
-        if (y & 1) {
-            for (int x = 0; x < w; x++) {
-                get(x, y)->setNeighbors({
-                    y > 0              ? get(x,   y-1) : nullptr,
-                    x > 0              ? get(x-1, y)   : nullptr,
-                    y+1 < h            ? get(x,   y+1) : nullptr,
-                    x+1 < w && y+1 < h ? get(x+1, y+1) : nullptr,
-                    x+1 < w            ? get(x+1, y)   : nullptr,
-                    x+1 < w && y > 0   ? get(x+1, y-1) : nullptr,
-                });
+        for (int x = 0; x < w; x++) {
+            for (int direction = 0; direction < 6; direction++) {
+                auto [dx, dy] = HexagonUtils::neighborOffset(y, direction);
+                int nx = x + dx;
+                int ny = y + dy;
+                bool inside = nx >= 0 && nx < w && ny >= 0 && ny < h;
+                neighbors[direction] = inside ? get(nx, ny) : nullptr;
             }
+            get(x, y)->setNeighbors(neighbors);
         }
+    }
 
-        // Event cell
-        else {
-            for (int x = 0; x < w; x++) {
-                get(x, y)->setNeighbors({
-                    x > 0 && y > 0     ? get(x-1, y-1) : nullptr,
-                    x > 0              ? get(x-1, y)   : nullptr,
-                    x > 0 && y+1 < h   ? get(x-1, y+1) : nullptr,
-                    y+1 < h            ? get(x,   y+1) : nullptr,
-                    x+1 < w            ? get(x+1, y)   : nullptr,
-                    y > 0              ? get(x,   y-1) : nullptr,
-                });
-            }
+    // Shields and fences depend on the neighbors
+    for (auto& cell : *this)
+        if (auto pg = PlayableGround::cast(cell)) {
+            pg->updateShield();
+            pg->invalidateFences();
         }
-    }
 }
 
 const bool GameMap::hasTroopSelected() {
@@ -327,6 +397,11 @@ void GameMap::setInSelectedCell(const std::shared_ptr<Cell>& cell) {
         pg->setPos(pos);
     }
 
+    // The replaced cell no longer holds a town
+    auto old = PlayableGround::cast(get(selectedCellPos_.getX(), selectedCellPos_.getY()));
+    if (auto owner = old ? old->getOwner() : nullptr)
+        owner->removeTownCell(old.get());
+
     set(selectedCellPos_.getX(), selectedCellPos_.getY(), cell);
     updateNeighbors();
 }
@@ -339,19 +414,18 @@ const int GameMap::getHeight() const {
 }
 
 void GameMap::addWidth(int delta) {
-    double islandInnerRadius = Ground::getInnerRadius();
-    double islandRadius = Ground::getRadius();
     HexagonGrid::addWidth(delta);
     if (delta > 0) {
         auto w = getWidth();
         auto h = getHeight();
-        for (int y = 0; y < h; y++) {
-            // Calculate pos of cell
-            auto [posX, posY] = HexagonUtils::offsetToPixel(w-1, y, islandRadius);
-            Point pos{static_cast<int>(posX + islandInnerRadius), static_cast<int>(posY + islandRadius)};
-            
-            set(w-1, y, std::make_shared<PlayableGround>(pos));
-        }
+
+        // Calculate pos of the cells of the new column
+        std::vector<int> xs(h, w-1), ys(h);
+        for (int y = 0; y < h; y++) ys[y] = y;
+        std::vector<Point> positions = getCellPositions(xs, ys);
+
+        for (int y = 0; y < h; y++)
+            set(w-1, y, std::make_shared<PlayableGround>(positions[y]));
     }
 
     updateNeighbors();
@@ -359,21 +433,19 @@ void GameMap::addWidth(int delta) {
 }
 
 void GameMap::addHeight(int delta) {
-    double islandInnerRadius = Ground::getInnerRadius();
-    double islandRadius = Ground::getRadius();
     HexagonGrid::addHeight(delta);
 
     if (delta > 0) {
         auto w = getWidth();
         auto h = getHeight();
 
-        for (int x = 0; x < w; x++) {
-            // Calculate pos of cell
-            auto [posX, posY] = HexagonUtils::offsetToPixel(x, h-1, islandRadius);
-            Point pos{static_cast<int>(posX + islandInnerRadius), static_cast<int>(posY + islandRadius)};
-            
-            set(x, h-1, std::make_shared<PlayableGround>(pos));
-        }
+        // Calculate pos of the cells of the new row
+        std::vector<int> xs(w), ys(w, h-1);
+        for (int x = 0; x < w; x++) xs[x] = x;
+        std::vector<Point> positions = getCellPositions(xs, ys);
+
+        for (int x = 0; x < w; x++)
+            set(x, h-1, std::make_shared<PlayableGround>(positions[x]));
     }
 
     updateNeighbors();
@@ -382,6 +454,10 @@ void GameMap::addHeight(int delta) {
 
 
 void GameMap::createCalcs() {
+    // Nothing to draw without renderer
+    if (isHeadless()) return;
+    geometry_ = HexagonUtils::Geometry{Ground::getRadius()};
+
     // Get utils dimensions
     Size islandSize = Ground::getIslandSize();
     double islandInnerRadius = Ground::getInnerRadius();
@@ -397,79 +473,259 @@ void GameMap::createCalcs() {
     calcSize_ = {static_cast<int>(cx), static_cast<int>(cy)};
     setProportionalSize(size_);
 
-    // Create calcs
-    calc_ = std::make_shared<Texture>(renderer_, calcSize_);
+    // Create the tiles of the map
+    tiles_ = std::make_shared<TileCache>(renderer_, calcSize_);
+    drawnStates_.clear();
+    viewport_ = Rect{Point{0, 0}, calcSize_};
+}
+
+void GameMap::invalidate() {
+    changed_ = true;
+}
+
+void GameMap::markChangedTiles() const {
+    if (!tiles_ || !changed_) return;
+    changed_ = false;
+    int w = getWidth();
+    drawnStates_.resize(static_cast<size_t>(w) * getHeight(), 0);
+
+    // Cells of the cached tiles drawn differently since their last drawing
+    double islandInnerRadius = Ground::getInnerRadius();
+    double islandRadius = Ground::getRadius();
+    Size islandSize = Ground::getIslandSize();
+    std::vector<Rect> changes;
+    for (const Rect& area : tiles_->getAreas()) {
+        Rect cells = getCellsIn(area);
+        for (int y = cells.getY(); y < cells.getY() + cells.getHeight(); y++) {
+            for (int x = cells.getX(); x < cells.getX() + cells.getWidth(); x++) {
+                std::uint64_t state = getDisplayState(get(x, y));
+                auto& drawnState = drawnStates_[y * w + x];
+                if (state == drawnState) continue;
+                drawnState = state;
+
+                // The cell and its neighbors, which its sprites overflow on
+                auto [posX, posY] = HexagonUtils::offsetToPixel(x, y, islandRadius);
+                Point center{static_cast<int>(posX + islandInnerRadius), static_cast<int>(posY + islandRadius)};
+                changes.emplace_back(center - islandSize * 3 / 2, islandSize * 3);
+            }
+        }
+    }
+
+    for (const Rect& change : changes)
+        tiles_->invalidate(change);
+}
+
+std::uint64_t GameMap::getDisplayState(const std::shared_ptr<Cell>& cell) const {
+    // Mix of the drawn values (boost::hash_combine)
+    std::uint64_t state = 0;
+    auto add = [&state](std::uint64_t value) { state ^= value + 0x9e3779b97f4a7c15ULL + (state << 6) + (state >> 2); };
+    auto addPtr = [&add](const void* ptr) { add(reinterpret_cast<std::uintptr_t>(ptr)); };
+
+    // Grounds and water never change, replaced cells are new objects
+    addPtr(cell.get());
+    auto pg = PlayableGround::cast(cell);
+    if (!pg) return state;
+
+    // Plate, fences and selection
+    auto owner = pg->getOwner();
+    auto lselectedCell = selectedCell_.lock();
+    addPtr(owner.get());
+    addPtr(pg->getOldOwner().get());
+    add(owner && owner->hasSelected());
+    add(pg->hasFences());
+    add(isReachable(pg->getIndex()));
+    add(pg == lselectedCell);
+    add(pg == lselectedCell && (selectedTroop_ || boughtElt_));
+
+    // Element or shield
+    auto elt = pg->getElement();
+    addPtr(elt.get());
+    if (!elt) {
+        add(pg->getShield());
+        return state;
+    }
+
+    add(elt->isLost());
+    if (auto troop = Troop::cast(elt)) {
+        add(troop->isFree());
+        add(troop->isMovable());
+    } else if (auto town = Town::cast(elt)) {
+        add(town == townToShowTreasury_.lock());
+        add(town->getTreasury());
+        add(town->getIncome());
+    } else if (auto camp = Camp::cast(elt)) {
+        add(camp == campToShowTreasury_.lock());
+        add(camp->getTreasury());
+    }
+    return state;
+}
+
+Rect GameMap::computeViewport(const Size& targetSize) const {
+    if (ratio_ <= 0) return Rect{0, 0, 0, 0};
+
+    // Displayed map clipped by the target, in pixels of the target
+    int left   = std::max(0, pos_.getX());
+    int top    = std::max(0, pos_.getY());
+    int right  = std::min(targetSize.getWidth(), pos_.getX() + size_.getWidth());
+    int bottom = std::min(targetSize.getHeight(), pos_.getY() + size_.getHeight());
+    if (right <= left || bottom <= top) return Rect{0, 0, 0, 0};
+
+    // Same part in pixels of the drawn map, rounded outwards
+    int x1 = std::max(0, static_cast<int>(std::floor((left - pos_.getX()) / ratio_)));
+    int y1 = std::max(0, static_cast<int>(std::floor((top - pos_.getY()) / ratio_)));
+    int x2 = std::min(calcSize_.getWidth(), static_cast<int>(std::ceil((right - pos_.getX()) / ratio_)));
+    int y2 = std::min(calcSize_.getHeight(), static_cast<int>(std::ceil((bottom - pos_.getY()) / ratio_)));
+    return Rect{x1, y1, x2 - x1, y2 - y1};
 }
 
+Rect GameMap::getCellsIn(const Rect& area) const {
+    // Pixel steps between the centers of the hexagons
+    double stepX = geometry_.getStepX();
+    double stepY = geometry_.getStepY();
 
-void GameMap::refreshIslands() const {
+    // Rows and columns overlapping the area, widened by the sprites overflowing their hexagon
+    Size islandSize = Ground::getIslandSize();
+    int yMin = std::max(0, static_cast<int>(std::floor((area.getY() - islandSize.getHeight()) / stepY)));
+    int yMax = std::min(getHeight() - 1, static_cast<int>(std::ceil((area.getY() + area.getHeight() + islandSize.getHeight()) / stepY)));
+    int xMin = std::max(0, static_cast<int>(std::floor((area.getX() - islandSize.getWidth()) / stepX)));
+    int xMax = std::min(getWidth() - 1, static_cast<int>(std::ceil((area.getX() + area.getWidth() + islandSize.getWidth()) / stepX)));
+    if (xMax < xMin || yMax < yMin) return Rect{0, 0, 0, 0};
+    return Rect{xMin, yMin, xMax - xMin + 1, yMax - yMin + 1};
+}
+
+template<typename F>
+void GameMap::forEachCellIn(const Rect& area, F&& f) const {
+    Rect cells = getCellsIn(area);
+    for (int y = cells.getY(); y < cells.getY() + cells.getHeight(); y++)
+        for (int x = cells.getX(); x < cells.getX() + cells.getWidth(); x++)
+            f(get(x, y));
+}
+
+
+void GameMap::refreshIslands(const std::shared_ptr<Texture>& target, const Rect& area) const {
     // Draw islands
-    for (auto& cell : *this)
+    forEachCellIn(area, [&](const std::shared_ptr<Cell>& cell) {
         if (auto g = Ground::cast(cell))
-            g->Ground::display(calc_);
+            g->Ground::display(target);
+    });
 }
 
-void GameMap::refreshPlates() const {
+void GameMap::refreshPlates(const std::shared_ptr<Texture>& target, const Rect& area) const {
     // Draw plates
-    for (auto& cell : *this)
+    forEachCellIn(area, [&](const std::shared_ptr<Cell>& cell) {
         if (auto ground = Ground::cast(cell))
-            ground->display(calc_);
+            ground->display(target);
+    });
 }
 
-void GameMap::refreshSelectables() const {
+void GameMap::refreshSelectables(const std::shared_ptr<Texture>& target, const Rect& area) const {
     auto lselectedCell = selectedCell_.lock();
     // Draw selectables
-    for (auto& cell : *this) {
-        if (auto pg = PlayableGround::cast(cell)) {
-            pg->displaySelectable(calc_, lselectedCell && cell == lselectedCell);
-        }
-    }
+    forEachCellIn(area, [&](const std::shared_ptr<Cell>& cell) {
+        auto pg = PlayableGround::cast(cell);
+        if (pg && isReachable(pg->getIndex()))
+            pg->displaySelectable(target, lselectedCell && cell == lselectedCell);
+    });
 }
 
-void GameMap::refreshFences() const {
+void GameMap::refreshFences(const std::shared_ptr<Texture>& target, const Rect& area) const {
     // Draw fences
-    for (auto& cell : *this)
+    forEachCellIn(area, [&](const std::shared_ptr<Cell>& cell) {
         if (auto pg = PlayableGround::cast(cell))
-            pg->displayFences(calc_);
+            pg->displayFences(target);
+    });
 }
 
-void GameMap::refreshElements() const {
+bool GameMap::refreshElements(const std::shared_ptr<Texture>& target, const Rect& area) const {
     auto lselectedCell = selectedCell_.lock();
     bool drawCross = lselectedCell && (selectedTroop_ || boughtElt_);
+    bool animated = false;
 
     // Draw game elements
-    for (auto& cell : *this) {
+    forEachCellIn(area, [&](const std::shared_ptr<Cell>& cell) {
         if (auto pg = PlayableGround::cast(cell)) {
-            pg->displayElement(calc_);
-            if (!drawCross || pg != lselectedCell || !pg->isSelectable())
-                pg->displayShield(calc_);
+            pg->displayElement(target);
+            if (!drawCross || pg != lselectedCell || !isReachable(pg->getIndex()))
+                pg->displayShield(target);
             else
-                pg->displayCross(calc_);
+                pg->displayCross(target);
+
+            // Movable troops bounce, so they are redrawn every frame
+            auto troop = Troop::cast(pg->getElement());
+            if (troop && troop->isMovable()) animated = true;
         }
-    }
+    });
 
     // draw treasury of town
     auto ltownToShowTreasury_ = townToShowTreasury_.lock();
     if (ltownToShowTreasury_)
-        ltownToShowTreasury_->displayTreasury(calc_);
+        ltownToShowTreasury_->displayTreasury(target);
 
     // draw treasury of camp
     auto lcampToShowTreasury_ = campToShowTreasury_.lock();
     if (lcampToShowTreasury_)
-        lcampToShowTreasury_->displayTreasury(calc_);
+        lcampToShowTreasury_->displayTreasury(target);
+
+    return animated;
 }
 
-void GameMap::refresh() const {
-    // Create calcs of map if isn't exists
-    if (!calc_) return;
+void GameMap::renderTile(TileCache::Tile& tile, const std::optional<Rect>& area) const {
+    const Rect& part = area ? *area : tile.rect;
 
     // Draw transparent background
-    calc_->fill(ColorUtils::toTransparent(ColorUtils::SEABLUE));
-    refreshIslands();
-    refreshPlates();
-    refreshSelectables();
-    refreshFences();
-    refreshElements();
+    tile.texture->fill(ColorUtils::toTransparent(ColorUtils::SEABLUE), part);
+    {
+        ProfileScope stage{"islands"};
+        refreshIslands(tile.texture, part);
+    }
+    {
+        ProfileScope stage{"plates"};
+        refreshPlates(tile.texture, part);
+    }
+    {
+        ProfileScope stage{"selectables"};
+        refreshSelectables(tile.texture, part);
+    }
+    {
+        ProfileScope stage{"fences"};
+        refreshFences(tile.texture, part);
+    }
+    {
+        ProfileScope stage{"elements"};
+        bool animated = refreshElements(tile.texture, part);
+
+        // A part only updates the animations of a clean tile
+        if (!area) {
+            tile.animated = animated;
+            tile.dirty = false;
+        }
+    }
+
+    // States of the drawn cells, compared by markChangedTiles()
+    if (area) return;
+    int w = getWidth();
+    drawnStates_.resize(static_cast<size_t>(w) * getHeight(), 0);
+    Rect cells = getCellsIn(tile.rect);
+    for (int y = cells.getY(); y < cells.getY() + cells.getHeight(); y++)
+        for (int x = cells.getX(); x < cells.getX() + cells.getWidth(); x++)
+            drawnStates_[y * w + x] = getDisplayState(get(x, y));
+}
+
+void GameMap::refresh() const {
+    if (!tiles_) return;
+    markChangedTiles();
+    if (viewport_.getWidth() <= 0 || viewport_.getHeight() <= 0) return;
+
+    ProfileScope scope{"refresh"};
+
+    // Redraw the changed visible tiles
+    Rect visibleTiles = tiles_->getTilesIn(viewport_);
+    for (int ty = visibleTiles.getY(); ty < visibleTiles.getY() + visibleTiles.getHeight(); ty++) {
+        for (int tx = visibleTiles.getX(); tx < visibleTiles.getX() + visibleTiles.getWidth(); tx++) {
+            TileCache::Tile& tile = tiles_->acquire(tx, ty);
+            if (tile.dirty) renderTile(tile);
+        }
+    }
 }
 
 
@@ -532,6 +788,18 @@ const bool GameMap::gameFinished() const {
     return gameFinished_;
 }
 
+const unsigned int GameMap::getSeed() const {
+    return seed_;
+}
+
+const std::vector<std::weak_ptr<Player>>& GameMap::getPlayers() const {
+    return players_;
+}
+
+std::shared_ptr<Player> GameMap::getCurrentPlayer() const {
+    return currentPlayer_.lock();
+}
+
 void GameMap::initGame() {
     // Any player found
     if (players_.empty()) {
@@ -552,9 +820,7 @@ void GameMap::initGame() {
     }
 
     // Update next income of players
-    for (auto& player : players_)
-        if (auto lplayer = player.lock())
-            updateIncomes(player);
+    updateAllIncomes();
 
     // Start turn of current player
     startTurn(currentPlayer_);
@@ -562,6 +828,7 @@ void GameMap::initGame() {
 }
 
 void GameMap::nextPlayer() {
+    invalidate();
     auto cp = currentPlayer_.lock();
     if (!cp || players_.empty()) {
         gameFinished_ = true;
@@ -588,11 +855,14 @@ void GameMap::nextPlayer() {
         return;
     }
 
+    // The turn passes to another player: record it (not after the end of the game)
+    if (!gameFinished_)
+        replay_.record(Action{Action::Type::EndTurn, Point{0, 0}, Point{0, 0}, '.'});
+
     // If first player
     if (selectedPlayerNum_ == 0) {
         moveBandits();
-        for (auto& player : players_)
-            updateIncomes(player);
+        updateAllIncomes();
     }
 
     // Start turn of new current player
@@ -616,12 +886,16 @@ void GameMap::startTurn(std::weak_ptr<Player>& player) {
 }
 
 std::unordered_map<std::shared_ptr<PlayableGround>, int> GameMap::getTreasuresOfCurrentPlayers() {
+    return getTreasuresOfPlayer(currentPlayer_);
+}
+
+std::unordered_map<std::shared_ptr<PlayableGround>, int> GameMap::getTreasuresOfPlayer(const std::weak_ptr<Player>& player) {
     std::unordered_map<std::shared_ptr<PlayableGround>, int> towns;
     std::unordered_set<std::shared_ptr<Town>> visited;
-    auto cp = currentPlayer_.lock();
-    if (!cp) return towns;
+    auto lplayer = player.lock();
+    if (!lplayer) return towns;
 
-    for (auto& cell : cp->getTownCells()) {
+    for (auto& cell : lplayer->getTownCells()) {
         auto pg = PlayableGround::cast(cell);
         if (!pg) continue;
 
@@ -644,6 +918,27 @@ std::unordered_map<std::shared_ptr<PlayableGround>, int> GameMap::getTreasuresOf
     return towns;
 }
 
+void GameMap::payPurchase(const std::shared_ptr<PlayableGround>& cell, int cost) {
+    if (!cell) return;
+
+    // Share purchase
+    for (auto& town : cell->getTowns()) {
+        if (auto ltown = town.lock()) {
+            int treasury = ltown->getTreasury();
+            if (treasury > cost) {
+                ltown->setTreasury(treasury - cost);
+                break;
+            }
+
+            cost -= treasury;
+            ltown->setTreasury(0);
+        }
+    }
+
+    if (auto cp = currentPlayer_.lock())
+        updateIncomes(cp);
+}
+
 const int GameMap::getMaxTreasuryOfCurrentPlayer() {
     auto treasures = getTreasuresOfCurrentPlayers();
     if (treasures.empty()) return 0;
@@ -656,6 +951,7 @@ const int GameMap::getMaxTreasuryOfCurrentPlayer() {
 }
 
 void GameMap::buyTroop(const std::shared_ptr<GameElement>& elt) {
+    invalidate();
     auto cp = currentPlayer_.lock();
     if (!cp || !elt) return;
 
@@ -671,7 +967,7 @@ void GameMap::buyTroop(const std::shared_ptr<GameElement>& elt) {
     for (auto& [townCell, treasury] : getTreasuresOfCurrentPlayers()) {
         if (townCell && treasury >= elt->getCost()) {
             potentialTownCells_.insert(townCell);
-            townCell->updateSelectable(Troop::is(elt) ? elt->getStrength() : 0);
+            showReachable(townCell, Troop::is(elt) ? elt->getStrength() : 0);
         }
     }
 }
@@ -719,23 +1015,18 @@ void GameMap::checkDeficits(std::weak_ptr<Player>& player) {
 }
 
 void GameMap::selectCell(const Point& pos) {
-    double islandInnerRadius = Ground::getInnerRadius();
-    double islandRadius = Ground::getRadius();
-    
-    // Calculate coords
-    Point relPos = pos / ratio_ - Point{static_cast<int>(islandInnerRadius), static_cast<int>(islandRadius)};
-    auto [x, y] = HexagonUtils::pixelToOffset(relPos.getX(), relPos.getY(), islandRadius);
-    Rect bounds{0, 0, getWidth(), getHeight()};
-    Point coords{x, y};
+    // Calculate coords (in fixed point, see HexagonUtils::Geometry)
+    Point relPos = pos / ratio_ - Point{static_cast<int>(Ground::getInnerRadius()), static_cast<int>(geometry_.getRadius())};
+    auto [x, y] = geometry_.pixelToOffset(relPos.getX(), relPos.getY());
+    selectedCellPos_ = Point{x, y};
 
     // Out of bounds
-    if (!bounds.contains(coords)) {
+    if (x < 0 || y < 0 || x >= getWidth() || y >= getHeight()) {
         selectedCell_.reset();
         return;
     }
     
     // Set selected cell
-    selectedCellPos_ = coords;
     if (auto pg = PlayableGround::cast(get(x, y)))
         selectedCell_ = pg;
 
@@ -776,7 +1067,7 @@ const bool GameMap::placeCastle(const std::weak_ptr<Castle>& castle, const std::
 void GameMap::moveTroop(const std::weak_ptr<PlayableGround>& from, const std::weak_ptr<PlayableGround>& to) {
     auto lfrom = from.lock();
     auto lto = to.lock();
-    if (!lfrom || !lto || lfrom == lto || !lto->isSelectable()) return;
+    if (!lfrom || !lto || lfrom == lto || !isReachable(lto->getIndex())) return;
 
     // Get interesting elements
     auto fromTroop = Troop::cast(lfrom->getElement());
@@ -975,13 +1266,14 @@ void GameMap::onMouseButtonDown(SDL_Event& event) {
     if (isSelectableTroop(lselectedCell)) {
         // Select element
         selectedTroopCell_ = lselectedCell;
+        selectedTroopCellPos_ = selectedCellPos_;
         selectedTroop_ = Troop::cast(lselectedCell->getElement());
 
         if (selectedTroop_) {
             selectedTroop_->setPos(mousePos);
             selectedTroop_->setMovable(false);
 
-            lselectedCell->updateSelectable(selectedTroop_->getStrength());
+            showReachable(lselectedCell, selectedTroop_->getStrength());
             lselectedCell->setElement(nullptr);
         }
     }
@@ -1005,6 +1297,7 @@ void GameMap::onMouseButtonDown(SDL_Event& event) {
 
         // Set town cell
         selectedTroopCell_ = lselectedCell;
+        selectedTroopCellPos_ = selectedCellPos_;
 
         // Create temp cell
         selectedNewTroopCell_ = std::make_shared<PlayableGround>(Point{0, 0});
@@ -1013,26 +1306,32 @@ void GameMap::onMouseButtonDown(SDL_Event& event) {
         // Set new troop
         selectedTroop_ = v;
         v->setPos(mousePos);
-        lselectedCell->updateSelectable(v->getStrength());
+        showReachable(lselectedCell, v->getStrength());
     }
 }
 
 void GameMap::onMouseMotion(SDL_Event& event) {
     Point mousePos{event.motion.x, event.motion.y};
     selectCell(mousePos - pos_);
-    townToShowTreasury_.reset();
-    campToShowTreasury_.reset();
 
     // Move selected troop
-    if (selectedTroop_) {
-        selectedTroop_->setPos(mousePos);
-        return;
-    } else if (boughtElt_) {
-        boughtElt_->setPos(mousePos);
+    if (selectedTroop_ || boughtElt_) {
+        townToShowTreasury_.reset();
+        campToShowTreasury_.reset();
+        hoveredCell_.reset();
+        (selectedTroop_ ? selectedTroop_ : boughtElt_)->setPos(mousePos);
         return;
     }
 
+    // Same hexagon in the same state: cursor and treasury are up to date
+    std::pair<int, int> hovered{selectedCellPos_.getX(), selectedCellPos_.getY()};
+    if (hoveredCell_ == hovered && hoveredHash_ == getHash()) return;
+    hoveredCell_ = hovered;
+    hoveredHash_ = getHash();
+
     // Check hover of elements
+    townToShowTreasury_.reset();
+    campToShowTreasury_.reset();
     updateCursor();
     if (auto lselectedCell = selectedCell_.lock()) {
         if (auto town = Town::cast(lselectedCell->getElement()))
@@ -1049,40 +1348,12 @@ void GameMap::onMouseButtonUp(SDL_Event& event) {
     // Buy by shop
     if (boughtElt_) {
         if (selectedNewTroopCell_ && lselectedCell && PlayableGround::is(lselectedCell)) {
-            selectedNewTroopCell_->setElement(boughtElt_);
-            int cost = boughtElt_->getCost();
-
-            // Move troop
-            if (auto castle = Castle::cast(boughtElt_)) {
-                if (placeCastle(castle, selectedCell_))
-                    selectedNewTroopCell_->setElement(nullptr);
-            } else if (auto troop = Troop::cast(boughtElt_)) {
-                troop->setMovable(true);
-                moveTroop(selectedNewTroopCell_, selectedCell_);
-            }
-
-            // Share purchase
-            if (!selectedNewTroopCell_->getElement()) {
-                for (auto& town : lselectedCell->getTowns()) {
-                    if (auto ltown = town.lock()) {
-                        int treasury = ltown->getTreasury();
-                        if (treasury > cost) {
-                            ltown->setTreasury(treasury - cost);
-                            break;
-                        }
-
-                        cost -= treasury;
-                        ltown->setTreasury(0);
-                    }
-                }
-                if (auto cp = currentPlayer_.lock())
-                    updateIncomes(cp);
-            }
+            auto type = Castle::is(boughtElt_) ? Action::Type::Castle : Action::Type::Buy;
+            applyAction(Action{type, selectedCellPos_, selectedCellPos_, GameElement::getLetter(boughtElt_), Action::Source::Shop});
         }
         
         // Remove possibilities
-        for (auto& townCell : potentialTownCells_)
-            townCell->updateSelectable(-1);
+        clearReachable();
     }
 
     // Buy by Town / Move troop
@@ -1090,35 +1361,11 @@ void GameMap::onMouseButtonUp(SDL_Event& event) {
 
         // Buy Troop
         if (selectedNewTroopCell_) {
-            if (lselectedCell && PlayableGround::is(lselectedCell)) {
-                selectedNewTroopCell_->setElement(selectedTroop_);
-                int cost = selectedTroop_->getCost();
-
-                // Move troop
-                selectedTroop_->setMovable(true);
-                moveTroop(selectedNewTroopCell_, selectedCell_);
-
-                // Share purchase
-                if (!selectedNewTroopCell_->getElement()) {
-                    for (auto& town : lselectedCell->getTowns()) {
-                        if (auto ltown = town.lock()) {
-                            int treasury = ltown->getTreasury();
-                            if (treasury > cost) {
-                                ltown->setTreasury(treasury - cost);
-                                break;
-                            }
-
-                            cost -= treasury;
-                            ltown->setTreasury(0);
-                        }
-                    }
-                    if (auto cp = currentPlayer_.lock())
-                        updateIncomes(cp);
-                }
-            }
+            if (lselectedCell && PlayableGround::is(lselectedCell))
+                applyAction(Action{Action::Type::Buy, selectedTroopCellPos_, selectedCellPos_, GameElement::getLetter(selectedTroop_)});
 
             // Remove possibilities
-            lselectedTroopCell->updateSelectable(-1);
+            clearReachable();
         }
 
         // Move Troop
@@ -1127,11 +1374,14 @@ void GameMap::onMouseButtonUp(SDL_Event& event) {
             selectedTroop_->setMovable(true);
     
             // Move troop
-            if (lselectedCell)
-                moveTroop(selectedTroopCell_, selectedCell_);
+            if (lselectedCell) {
+                auto target = Troop::cast(lselectedCell->getElement());
+                bool merge = target && !Bandit::is(target) && lselectedCell != lselectedTroopCell && lselectedCell->getOwner() == lselectedTroopCell->getOwner();
+                applyAction(Action{merge ? Action::Type::Merge : Action::Type::Move, selectedTroopCellPos_, selectedCellPos_, '.'});
+            }
     
             // Remove possibilities
-            lselectedTroopCell->updateSelectable(-1);
+            clearReachable();
         }
     }
 
@@ -1145,23 +1395,63 @@ void GameMap::onMouseButtonUp(SDL_Event& event) {
 
 void GameMap::handleEvent(SDL_Event &event) {
     switch (event.type) {
-        case SDL_MOUSEBUTTONDOWN: onMouseButtonDown(event); break;
-        case SDL_MOUSEMOTION: onMouseMotion(event); break;
-        case SDL_MOUSEBUTTONUP: onMouseButtonUp(event); break;
+        case SDL_MOUSEBUTTONDOWN: onMouseButtonDown(event); invalidate(); break;
+        case SDL_MOUSEBUTTONUP: onMouseButtonUp(event); invalidate(); break;
+        case SDL_MOUSEMOTION: {
+            // Redraw only if the hovered cell or the shown treasury changed
+            auto oldSelectedCell = selectedCell_.lock();
+            auto oldTown = townToShowTreasury_.lock();
+            auto oldCamp = campToShowTreasury_.lock();
+            onMouseMotion(event);
+            if (selectedCell_.lock() != oldSelectedCell || townToShowTreasury_.lock() != oldTown || campToShowTreasury_.lock() != oldCamp)
+                invalidate();
+            break;
+        }
     }
 }
 
 void GameMap::display(const std::weak_ptr<BlitTarget>& target) const {
-    // Check initialized calcs
-    refresh();
-
     // Check target
     auto ltarget = target.lock();
     if (!ltarget) return;
 
-    // Show map
-    Rect dest = {pos_, size_};
-    if (calc_) ltarget->blit(calc_, dest);
+    // Redraw the dirty tiles visible on the target and show them
+    if (tiles_) {
+        markChangedTiles();
+        viewport_ = computeViewport(ltarget->getSize());
+
+        // Zoomed out: tiles drawn at the closest scale above ratio_, from pre-scaled sprites
+        int level = 0;
+        while (level < TileCache::MAX_LEVEL && ratio_ * (2 << level) <= 1.0) level++;
+        tiles_->setLevel(level);
+        Rect visibleTiles = tiles_->getTilesIn(viewport_);
+
+        ProfileScope scope{"refresh"};
+        for (int ty = visibleTiles.getY(); ty < visibleTiles.getY() + visibleTiles.getHeight(); ty++) {
+            for (int tx = visibleTiles.getX(); tx < visibleTiles.getX() + visibleTiles.getWidth(); tx++) {
+                TileCache::Tile& tile = tiles_->acquire(tx, ty);
+                const Rect& r = tile.rect;
+                if (tile.dirty)
+                    renderTile(tile);
+
+                // Animated tile: only its visible part changes
+                else if (tile.animated) {
+                    int left = std::max(r.getX(), viewport_.getX());
+                    int top = std::max(r.getY(), viewport_.getY());
+                    int right = std::min(r.getX() + r.getWidth(), viewport_.getX() + viewport_.getWidth());
+                    int bottom = std::min(r.getY() + r.getHeight(), viewport_.getY() + viewport_.getHeight());
+                    renderTile(tile, Rect{left, top, right - left, bottom - top});
+                }
+
+                // Edges scaled one by one, so that neighbor tiles meet without gap
+                int x1 = pos_.getX() + static_cast<int>(std::lround(r.getX() * ratio_));
+                int y1 = pos_.getY() + static_cast<int>(std::lround(r.getY() * ratio_));
+                int x2 = pos_.getX() + static_cast<int>(std::lround((r.getX() + r.getWidth()) * ratio_));
+                int y2 = pos_.getY() + static_cast<int>(std::lround((r.getY() + r.getHeight()) * ratio_));
+                ltarget->blit(tile.texture, tile.source, Rect{x1, y1, x2 - x1, y2 - y1});
+            }
+        }
+    }
 
     // Show selected troop
     if (selectedTroop_) selectedTroop_->display(ltarget);
@@ -1212,6 +1502,166 @@ void GameMap::updateIncomes(std::shared_ptr<Player>& player) {
     updateIncomes(wplayer);
 }
 
+void GameMap::updateAllIncomes() {
+    // Get treasures and reset incomes
+    std::map<std::shared_ptr<Town>, int> towns;
+    std::unordered_set<std::shared_ptr<Player>> players;
+    for (auto& player : players_) {
+        auto lplayer = player.lock();
+        if (!lplayer) continue;
+
+        players.insert(lplayer);
+        for (auto& townCell : lplayer->getTownCells()) {
+            if (auto ltownCell = townCell.lock()) {
+                auto town = Town::cast(ltownCell->getElement());
+                towns[town] = town->getTreasury();
+                town->setIncome(0);
+            }
+        }
+    }
+
+    // Index grounds of the grid
+    int nbCells = getWidth() * getHeight();
+    incomesGrounds_.clear();
+    for (auto& cell : *this)
+        incomesGrounds_.push_back(dynamic_cast<PlayableGround*>(cell.get()));
+    incomesRegions_.assign(nbCells, -1);
+    incomesDistances_.assign(nbCells, -1);
+    incomesNearest_.assign(nbCells, -1);
+    incomesRegionCells_.clear();
+    incomesRegionList_.clear();
+
+    for (int start = 0; start < nbCells; start++) {
+        PlayableGround* startGround = incomesGrounds_[start];
+        auto owner = startGround ? startGround->getOwner() : nullptr;
+        if (!owner || incomesRegions_[start] != -1 || !players.contains(owner))
+            continue;
+
+        // Flood the region of the owner and search its towns
+        int region = static_cast<int>(incomesRegionList_.size());
+        auto& current = incomesRegionList_.emplace_back();
+        current.begin = incomesRegionCells_.size();
+        incomesRegions_[start] = region;
+        incomesRegionCells_.push_back(start);
+
+        for (size_t i = current.begin; i < incomesRegionCells_.size(); i++) {
+            int index = incomesRegionCells_[i];
+            if (Town::is(incomesGrounds_[index]->getElement()))
+                current.townCells.push_back(index);
+
+            for (int direction = 0; direction < 6; direction++) {
+                int neighbor = getNeighborIndex(index, direction);
+                if (neighbor < 0 || incomesRegions_[neighbor] != -1) continue;
+
+                PlayableGround* ground = incomesGrounds_[neighbor];
+                if (ground && ground->getOwner() == owner) {
+                    incomesRegions_[neighbor] = region;
+                    incomesRegionCells_.push_back(neighbor);
+                }
+            }
+        }
+        current.end = incomesRegionCells_.size();
+    }
+
+    // Calculate incomes of the regions, posted to the workers on large maps
+    int nbRegions = static_cast<int>(incomesRegionList_.size());
+    if (!regionWorkers_ || nbCells < REGION_THREADS_MIN_CELLS) {
+        incomesQueues_.resize(1);
+        for (int region = 0; region < nbRegions; region++)
+            updateRegionIncomes(region, incomesQueues_[0]);
+    } else {
+        incomesQueues_.resize(regionWorkers_->getSize());
+        regionWorkers_->run(nbRegions, [this](int region, int worker) {
+            updateRegionIncomes(region, incomesQueues_[worker]);
+        });
+    }
+
+    // Give incomes to towns, in the order of the regions
+    for (auto& region : incomesRegionList_)
+        for (size_t i = 0; i < region.townCells.size(); i++)
+            if (region.incomes[i] != 0)
+                Town::cast(incomesGrounds_[region.townCells[i]]->getElement())->addIncome(region.incomes[i]);
+
+    // Share deficits
+    for (auto& player : players_) {
+        auto lplayer = player.lock();
+        if (!lplayer) continue;
+
+        for (auto& townCell : lplayer->getTownCells()) {
+            if (auto ltownCell = townCell.lock()) {
+                auto town = Town::cast(ltownCell->getElement());
+                town->updateTreasury();
+            }
+        }
+        checkDeficits(player);
+    }
+
+    // restore treasures
+    for (auto& [town, treasury] : towns)
+        town->setTreasury(treasury);
+}
+
+void GameMap::updateRegionIncomes(int region, std::vector<int>& queue) {
+    auto& current = incomesRegionList_[region];
+    size_t nbTowns = current.townCells.size();
+    current.incomes.assign(nbTowns, 0);
+
+    // Nearest town of each cell, flooding from every town at once
+    if (nbTowns > 1) {
+        queue.clear();
+        for (size_t i = 0; i < current.townCells.size(); i++) {
+            int index = current.townCells[i];
+            incomesDistances_[index] = 0;
+            incomesNearest_[index] = static_cast<int>(i);
+            queue.push_back(index);
+        }
+
+        for (size_t i = 0; i < queue.size(); i++) {
+            int index = queue[i];
+            for (int direction = 0; direction < 6; direction++) {
+                int neighbor = getNeighborIndex(index, direction);
+                if (neighbor < 0 || incomesRegions_[neighbor] != region) continue;
+
+                if (incomesDistances_[neighbor] == -1) {
+                    incomesDistances_[neighbor] = incomesDistances_[index] + 1;
+                    incomesNearest_[neighbor] = incomesNearest_[index];
+                    queue.push_back(neighbor);
+                } else if (incomesDistances_[neighbor] == incomesDistances_[index] + 1 && incomesNearest_[neighbor] != incomesNearest_[index]) {
+                    incomesNearest_[neighbor] = TIED_TOWNS;
+                }
+            }
+        }
+    }
+
+    // Sum incomes of the cells of each town
+    for (size_t i = current.begin; i < current.end; i++) {
+        int index = incomesRegionCells_[i];
+        PlayableGround* ground = incomesGrounds_[index];
+        int income = ground->getIncome();
+        int nearest = nbTowns == 1 ? 0 : incomesNearest_[index];
+
+        // Tie broken by the search of the cell itself
+        if (nearest == TIED_TOWNS && income != 0) {
+            auto town = ground->getNearestTown();
+            auto townCell = std::find_if(current.townCells.begin(), current.townCells.end(), [&](int cell) {
+                return incomesGrounds_[cell]->getElement() == town;
+            });
+            nearest = static_cast<int>(townCell - current.townCells.begin());
+        }
+        if (nearest >= 0 && nearest < static_cast<int>(nbTowns))
+            current.incomes[nearest] += income;
+
+        auto troop = Troop::cast(ground->getElement());
+        if (troop && !Bandit::cast(troop))
+            troop->setFree(false);
+    }
+}
+
+void GameMap::setRegionThreads(int nbThreads) {
+    if (nbThreads <= 1) regionWorkers_.reset();
+    else if (!regionWorkers_ || regionWorkers_->getSize() != nbThreads) regionWorkers_ = std::make_unique<WorkerPool>(nbThreads);
+}
+
 void GameMap::updateMovables() {
     auto cp = currentPlayer_.lock();
     for (auto& cell : *this)
@@ -1222,12 +1672,19 @@ void GameMap::updateMovables() {
 
 void GameMap::undo() {
     if (nbUndos_ < 1) return;
+    invalidate();
+    replay_.record(Action{Action::Type::Undo, Point{0, 0}, Point{0, 0}, '.'});
     std::pair<int, int> gridSize{getWidth(), getHeight()};
     movedTroops_ = movedTroopsSave_;
     auto oldGrid = saves_.back();
     saves_.pop_back();
     nbUndos_--;
 
+    // Towns of players are those of the old cells
+    for (auto& player : players_)
+        if (auto lplayer = player.lock())
+            lplayer->clearTownCells();
+
     // Place old cells
     for (int x = 0; x < gridSize.first; x++) {
         for (int y = 0; y < gridSize.second; y++) {
@@ -1247,11 +1704,6 @@ void GameMap::undo() {
     // Update neighbors
     updateNeighbors();
     updateMovables();
-
-    // refresh towns of players
-    for (auto player : players_)
-        if (auto lplayer = player.lock())
-            lplayer->updateTowns();
 }
 
 void GameMap::save() {
@@ -1294,3 +1746,321 @@ void GameMap::updateFreeTroops(const std::weak_ptr<Player>& player) {
         pg->setElement(std::make_shared<Bandit>(pg->getPos()));
     }
 }
+
+const int GameMap::getNeighborIndex(int index, int direction) const {
+    int w = getWidth();
+    int x = index % w;
+    int y = index / w;
+    auto [dx, dy] = HexagonUtils::neighborOffset(y, direction);
+
+    int nx = x + dx;
+    int ny = y + dy;
+    if (nx < 0 || nx >= w || ny < 0 || ny >= getHeight())
+        return -1;
+
+    return ny * w + nx;
+}
+
+void GameMap::generateTargets(std::vector<Action>& moves, Action::Type type, int from, int strength, char letter) {
+    int w = getWidth();
+    Point fromCoords{from % w, from / w};
+
+    // Cells of the region (see getReachable and moveTroop)
+    for (int index : movesRegionCells_) {
+        if (index == from) continue;
+
+        auto elt = movesGrounds_[index]->getElement();
+        auto troop = Troop::cast(elt);
+        Action::Type actionType = type;
+
+        if (elt && !Bandit::is(elt)) {
+            // Only troops of the same kind can be merged
+            if (!troop || Hero::is(troop) || troop->getStrength() != strength)
+                continue;
+            if (type == Action::Type::Move)
+                actionType = Action::Type::Merge;
+        }
+
+        moves.push_back(Action{actionType, fromCoords, Point{index % w, index / w}, letter});
+    }
+
+    // Cells around the region
+    if (strength <= 0) return;
+    for (auto& [index, shield] : movesBorderCells_)
+        if (shield < strength)
+            moves.push_back(Action{type, fromCoords, Point{index % w, index / w}, letter});
+}
+
+const Bitboard& GameMap::getReachable(int cell, int strength) {
+    if (strength < 0 || strength >= REACHABLE_STRENGTHS)
+        throw std::runtime_error("Force de troupe invalide: " + std::to_string(strength));
+
+    // Cached regions are those of another state
+    if (reachableHash_ != getHash()) {
+        reachableHash_ = getHash();
+        reachableRegions_.clear();
+    }
+
+    // Region of the cell, flooded on the owner's board
+    auto it = std::find_if(reachableRegions_.begin(), reachableRegions_.end(), [cell](const ReachableRegion& region) {
+        return region.cells.test(cell);
+    });
+    if (it == reachableRegions_.end()) {
+        reachableRegions_.push_back(ReachableRegion{bitboards_->getRegion(cell)});
+        it = std::prev(reachableRegions_.end());
+    }
+
+    // Region and weaker cells around it
+    auto& set = it->sets[strength];
+    if (set.getWords().empty())
+        set = bitboards_->getReachable(it->cells, strength);
+    return set;
+}
+
+void GameMap::showReachable(const std::shared_ptr<PlayableGround>& pg, int strength) {
+    if (!pg || pg->getIndex() < 0) return;
+
+    const auto& set = getReachable(pg->getIndex(), strength);
+    if (reachable_.getWords().size() != set.getWords().size())
+        reachable_ = set;
+    else
+        reachable_ |= set;
+}
+
+void GameMap::clearReachable() {
+    reachable_.clear();
+}
+
+const bool GameMap::isReachable(int cell) const {
+    if (cell < 0 || cell >= reachable_.getWidth() * reachable_.getHeight()) return false;
+    return reachable_.test(cell);
+}
+
+void GameMap::generateMoves(const std::weak_ptr<Player>& player, std::vector<Action>& moves) {
+    moves.clear();
+    auto lplayer = player.lock();
+    if (!lplayer || lplayer != currentPlayer_.lock() || gameFinished_) return;
+
+    // Index grounds of the grid
+    int nbCells = getWidth() * getHeight();
+    movesGrounds_.clear();
+    for (auto& cell : *this)
+        movesGrounds_.push_back(PlayableGround::cast(cell));
+    movesRegions_.assign(nbCells, -1);
+    movesMarks_.assign(nbCells, -1);
+
+    // Treasures of regions
+    auto treasures = getTreasuresOfPlayer(lplayer);
+    int maxTreasury = 0;
+    for (const auto& [townCell, treasury] : treasures)
+        maxTreasury = std::max(maxTreasury, treasury);
+
+    int nbRegions = 0;
+    for (int start = 0; start < nbCells; start++) {
+        auto& startGround = movesGrounds_[start];
+        if (!startGround || startGround->getOwner() != lplayer || movesRegions_[start] != -1)
+            continue;
+
+        // Flood the region of the player
+        int region = nbRegions++;
+        movesRegionCells_.clear();
+        movesBorderCells_.clear();
+        movesRegions_[start] = region;
+        movesRegionCells_.push_back(start);
+
+        for (size_t i = 0; i < movesRegionCells_.size(); i++) {
+            int index = movesRegionCells_[i];
+            for (int direction = 0; direction < 6; direction++) {
+                int neighbor = getNeighborIndex(index, direction);
+                if (neighbor < 0) continue;
+
+                auto& ground = movesGrounds_[neighbor];
+                if (!ground) continue;
+
+                if (ground->getOwner() == lplayer) {
+                    if (movesRegions_[neighbor] == -1) {
+                        movesRegions_[neighbor] = region;
+                        movesRegionCells_.push_back(neighbor);
+                    }
+                } else if (movesMarks_[neighbor] != region) {
+                    movesMarks_[neighbor] = region;
+                    movesBorderCells_.emplace_back(neighbor, ground->getShield());
+                }
+            }
+        }
+
+        // Troops of the region
+        int townIndex = -1;
+        int treasury = 0;
+        for (int index : movesRegionCells_) {
+            auto& ground = movesGrounds_[index];
+            auto elt = ground->getElement();
+
+            if (Town::is(elt)) {
+                auto it = treasures.find(ground);
+                if (it != treasures.end()) {
+                    townIndex = index;
+                    treasury = it->second;
+                }
+                continue;
+            }
+
+            auto troop = Troop::cast(elt);
+            if (!troop || Bandit::is(troop) || isMovedTroop(troop)) continue;
+            generateTargets(moves, Action::Type::Move, index, troop->getStrength(), '.');
+        }
+
+        // Purchases of the region
+        if (townIndex != -1)
+            for (const auto& shopTroop : getShopTroops())
+                if (treasury >= shopTroop.cost)
+                    generateTargets(moves, Action::Type::Buy, townIndex, shopTroop.strength, shopTroop.letter);
+    }
+
+    // Castles can be placed on any empty cell of the player
+    if (maxTreasury >= Castle::SHOP_TREASURY) {
+        int w = getWidth();
+        for (int index = 0; index < nbCells; index++) {
+            auto& ground = movesGrounds_[index];
+            if (ground && ground->getOwner() == lplayer && !ground->getElement()) {
+                Point coords{index % w, index / w};
+                moves.push_back(Action{Action::Type::Castle, coords, coords, 'C'});
+            }
+        }
+    }
+
+    moves.push_back(Action{Action::Type::EndTurn, Point{0, 0}, Point{0, 0}, '.'});
+    movesGrounds_.clear();
+}
+
+const bool GameMap::applyAction(const Action& action) {
+    auto cp = currentPlayer_.lock();
+    if (!cp || gameFinished_) return false;
+    invalidate();
+
+    // End of turn
+    if (action.type == Action::Type::EndTurn) {
+        nextPlayer();
+        return true;
+    }
+
+    // Undo
+    if (action.type == Action::Type::Undo) {
+        int nbUndos = nbUndos_;
+        undo();
+        return nbUndos_ != nbUndos;
+    }
+
+    // Get cells
+    Rect bounds{0, 0, getWidth(), getHeight()};
+    if (!bounds.contains(action.from) || !bounds.contains(action.to)) return false;
+    auto from = PlayableGround::cast(get(action.from.getX(), action.from.getY()));
+    auto to = PlayableGround::cast(get(action.to.getX(), action.to.getY()));
+    if (!from || !to) return false;
+
+    bool played = false;
+    switch (action.type) {
+        // Move troop
+        case Action::Type::Move:
+        case Action::Type::Merge: {
+            if (!isSelectableTroop(from)) return false;
+            auto troop = Troop::cast(from->getElement());
+
+            int nbUndos = nbUndos_;
+            showReachable(from, troop->getStrength());
+            moveTroop(from, to);
+            clearReachable();
+            played = nbUndos_ != nbUndos;
+            break;
+        }
+
+        // Buy troop: from a town, in its region; from the shop, in any region able to pay
+        case Action::Type::Buy: {
+            auto troop = Troop::cast(createGameElement(action.element, to->getPos()));
+            if (!troop || Bandit::is(troop)) return false;
+
+            // Regions able to pay
+            std::vector<std::shared_ptr<PlayableGround>> townCells;
+            if (action.source == Action::Source::Town) {
+                if (!Town::is(from->getElement()) || from->getOwner() != cp) return false;
+
+                int treasury = 0;
+                for (auto& town : from->getTowns())
+                    if (auto ltown = town.lock())
+                        treasury += ltown->getTreasury();
+                if (treasury >= troop->getCost())
+                    townCells.push_back(from);
+            } else {
+                for (auto& [townCell, treasury] : getTreasuresOfPlayer(cp))
+                    if (townCell && treasury >= troop->getCost())
+                        townCells.push_back(townCell);
+            }
+            if (townCells.empty()) return false;
+
+            // Create temp cell
+            auto newTroopCell = std::make_shared<PlayableGround>(Point{0, 0});
+            newTroopCell->setOwner(cp);
+            newTroopCell->setElement(troop);
+            troop->setMovable(true);
+
+            // Move troop
+            for (auto& townCell : townCells)
+                showReachable(townCell, troop->getStrength());
+            moveTroop(newTroopCell, to);
+            played = !newTroopCell->getElement();
+            if (played)
+                payPurchase(to, troop->getCost());
+            clearReachable();
+            break;
+        }
+
+        // Place castle
+        case Action::Type::Castle: {
+            if (getMaxTreasuryOfCurrentPlayer() < Castle::SHOP_TREASURY) return false;
+            auto castle = std::make_shared<Castle>(to->getPos());
+            if (!placeCastle(castle, to)) return false;
+
+            payPurchase(to, castle->getCost());
+            played = true;
+            break;
+        }
+
+        default: return false;
+    }
+
+    if (played)
+        replay_.record(action);
+    return played;
+}
+
+const Replay& GameMap::getReplay() const {
+    return replay_;
+}
+
+const std::uint64_t GameMap::getHash() const {
+    auto cp = currentPlayer_.lock();
+    return (hash_ ? hash_->get() : 0) ^ ZobristHash::sideKey(cp && !gameFinished_ ? cp->getNum() : 0);
+}
+
+const MapBitboards& GameMap::getBitboards() const {
+    return *bitboards_;
+}
+
+const std::uint64_t GameMap::computeHash() const {
+    auto cp = currentPlayer_.lock();
+    std::uint64_t hash = ZobristHash::sideKey(cp && !gameFinished_ ? cp->getNum() : 0);
+    int w = getWidth();
+    int h = getHeight();
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            if (auto pg = PlayableGround::cast(get(x, y))) {
+                auto owner = pg->getOwner();
+                hash ^= ZobristHash::ownerKey(y * w + x, owner ? owner->getNum() : 0);
+                hash ^= ZobristHash::elementKey(y * w + x, pg->getElement());
+            }
+        }
+    }
+
+    return hash;
+}
@@ -106,7 +106,7 @@ void Overlay::update(int treasury) {
     options_[1].buyable = treasury >= 20;
     options_[2].buyable = treasury >= 40;
     options_[3].buyable = treasury >= 80;
-    options_[4].buyable = treasury >= 20;
+    options_[4].buyable = treasury >= Castle::SHOP_TREASURY;
 }
 
 void Overlay::handleEvent(const SDL_Event& e) {
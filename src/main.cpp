@@ -1,8 +1,18 @@
 #include "Game.hpp"
 #include <iostream>
+#include <string>
 
 int main(int argc, char* argv[]) {
-    Game game;
+    // Options: --replay FILE [--speed MS]
+    std::string replayFile;
+    int replayDelay = 500;
+    for (int i = 1; i + 1 < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--replay") replayFile = argv[++i];
+        else if (arg == "--speed") replayDelay = std::stoi(argv[++i]);
+    }
+
+    Game game{replayFile, replayDelay};
     game.run();
 
     return 0;